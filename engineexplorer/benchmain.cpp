@@ -0,0 +1,86 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <iostream>
+
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <KAboutData>
+#include <KLocalizedString>
+
+#include <qcommandlineparser.h>
+#include <qcommandlineoption.h>
+
+#include "enginebenchmark.h"
+
+int main(int argc, char **argv)
+{
+    // engines may use pixmaps or fonts, but nothing is ever shown
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+
+    KLocalizedString::setApplicationDomain("plasmaengineexplorer");
+
+    KAboutData aboutData("engineexplorer-bench", i18n("Plasma Engine Benchmark"),
+                         PROJECT_VERSION, i18n("Measure how Plasma DataEngines deliver their data"),
+                         KAboutLicense::GPL,
+                         i18n("(c) 2026, The KDE Team"));
+    KAboutData::setApplicationData(aboutData);
+
+    QCommandLineParser parser;
+    aboutData.setupCommandLine(&parser);
+    parser.addOption(QCommandLineOption(QStringList() << "engine", i18n("The data engine to measure"), "data engine"));
+    parser.addOption(QCommandLineOption(QStringList() << "source", i18n("A source to connect, can be given more than once; "
+                                           "defaults to the sources the engine publishes"), "source"));
+    parser.addOption(QCommandLineOption(QStringList() << "max-sources", i18n("Connect at most this many sources"), "count"));
+    parser.addOption(QCommandLineOption(QStringList() << "connect-interval", i18n("Time between connecting two sources in milliseconds"), "ms", "0"));
+    parser.addOption(QCommandLineOption(QStringList() << "interval", i18n("Update interval requested from the sources in milliseconds"), "ms", "0"));
+    parser.addOption(QCommandLineOption(QStringList() << "duration", i18n("How long to measure after the last source got connected, in milliseconds"), "ms", "10000"));
+
+    parser.process(app);
+    aboutData.processCommandLine(&parser);
+
+    EngineBenchmark::Parameters parameters;
+    parameters.engine = parser.value("engine");
+    if (parameters.engine.isEmpty()) {
+        std::cerr << i18n("No data engine given, use --engine").toLocal8Bit().constData() << std::endl;
+        return 1;
+    }
+
+    parameters.sources = parser.values("source");
+    parameters.sourceCount = parser.value("max-sources").toInt();
+    parameters.connectInterval = parser.value("connect-interval").toInt();
+    parameters.updateInterval = parser.value("interval").toInt();
+    parameters.duration = parser.value("duration").toInt();
+
+    EngineBenchmark benchmark;
+    QObject::connect(&benchmark, &EngineBenchmark::finished, &app, [&benchmark](int exitCode) {
+        std::cout << QJsonDocument(benchmark.report()).toJson(QJsonDocument::Indented).constData();
+        QCoreApplication::exit(exitCode);
+    }, Qt::QueuedConnection);
+
+    if (!benchmark.start(parameters)) {
+        return 1;
+    }
+
+    return app.exec();
+}
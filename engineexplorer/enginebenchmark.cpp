@@ -0,0 +1,289 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "enginebenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <iostream>
+
+#include <QFile>
+#include <QJsonArray>
+
+#include <KLocalizedString>
+
+#include <Plasma/PluginLoader>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+// bump when the meaning of an existing key of the report changes
+static const int s_reportVersion = 1;
+
+static QJsonValue milliseconds(qint64 nsecs)
+{
+    if (nsecs < 0) {
+        return QJsonValue(QJsonValue::Null);
+    }
+
+    return std::round(nsecs / 1000.0) / 1000.0;
+}
+
+static qint64 percentile(QVector<qint64> values, int percent)
+{
+    if (values.isEmpty()) {
+        return -1;
+    }
+
+    std::sort(values.begin(), values.end());
+    const int rank = qMax(1, (percent * values.count() + 99) / 100);
+    return values.at(qMin(rank, values.count()) - 1);
+}
+
+static QJsonObject distribution(const QVector<qint64> &values)
+{
+    QJsonObject result;
+    result.insert(QStringLiteral("count"), values.count());
+    result.insert(QStringLiteral("p50Ms"), milliseconds(percentile(values, 50)));
+    result.insert(QStringLiteral("p95Ms"), milliseconds(percentile(values, 95)));
+    result.insert(QStringLiteral("maxMs"), milliseconds(percentile(values, 100)));
+    return result;
+}
+
+EngineBenchmark::EngineBenchmark(QObject *parent)
+    : QObject(parent),
+      m_engine(nullptr),
+      m_updates(0),
+      m_startMemory(-1),
+      m_endMemory(-1),
+      m_startCpu(-1),
+      m_endCpu(-1),
+      m_end(-1)
+{
+    connect(&m_connectTimer, SIGNAL(timeout()), this, SLOT(connectNextSource()));
+}
+
+EngineBenchmark::~EngineBenchmark()
+{
+}
+
+bool EngineBenchmark::start(const Parameters &parameters)
+{
+    m_parameters = parameters;
+    m_engine = Plasma::PluginLoader::self()->loadDataEngine(parameters.engine);
+    if (!m_engine || !m_engine->isValid()) {
+        std::cerr << i18n("Could not load the data engine %1", parameters.engine).toLocal8Bit().constData() << std::endl;
+        return false;
+    }
+
+    m_toConnect = parameters.sources.isEmpty() ? m_engine->sources() : parameters.sources;
+    m_toConnect.removeDuplicates();
+    if (parameters.sourceCount > 0) {
+        m_toConnect = m_toConnect.mid(0, parameters.sourceCount);
+    }
+
+    if (m_toConnect.isEmpty()) {
+        std::cerr << i18n("The data engine %1 has no sources to connect", parameters.engine).toLocal8Bit().constData() << std::endl;
+        return false;
+    }
+
+    // the engine itself is loaded by now, only what connecting the sources
+    // costs is measured
+    m_startMemory = residentMemory();
+    m_startCpu = cpuTime();
+    m_clock.start();
+
+    m_connectTimer.setInterval(qMax(0, parameters.connectInterval));
+    connectNextSource();
+    return true;
+}
+
+void EngineBenchmark::connectNextSource()
+{
+    do {
+        const QString source = m_toConnect.takeFirst();
+
+        // engines may deliver data from within connectSource() already
+        m_timings[source].connected = m_clock.nsecsElapsed();
+        m_engine->connectSource(source, this, qMax(0, m_parameters.updateInterval));
+    } while (m_parameters.connectInterval <= 0 && !m_toConnect.isEmpty());
+
+    if (m_toConnect.isEmpty()) {
+        m_connectTimer.stop();
+        QTimer::singleShot(qMax(0, m_parameters.duration), this, SLOT(stop()));
+    } else if (!m_connectTimer.isActive()) {
+        m_connectTimer.start();
+    }
+}
+
+void EngineBenchmark::dataUpdated(const QString &source, const Plasma::DataEngine::Data &data)
+{
+    Q_UNUSED(data)
+
+    auto it = m_timings.find(source);
+    if (m_end >= 0 || it == m_timings.end()) {
+        return;
+    }
+
+    const qint64 now = m_clock.nsecsElapsed();
+    if (it->firstUpdate < 0) {
+        it->firstUpdate = now;
+    } else {
+        it->intervals << now - it->lastUpdate;
+    }
+
+    it->lastUpdate = now;
+    ++m_updates;
+}
+
+void EngineBenchmark::stop()
+{
+    m_end = m_clock.nsecsElapsed();
+    m_endMemory = residentMemory();
+    m_endCpu = cpuTime();
+
+    bool anyData = false;
+    for (auto it = m_timings.constBegin(); it != m_timings.constEnd(); ++it) {
+        m_engine->disconnectSource(it.key(), this);
+        anyData = anyData || it->firstUpdate >= 0;
+    }
+
+    emit finished(anyData ? 0 : 1);
+}
+
+QJsonObject EngineBenchmark::report() const
+{
+    QJsonObject parameters;
+    parameters.insert(QStringLiteral("sources"), m_timings.count());
+    parameters.insert(QStringLiteral("connectIntervalMs"), m_parameters.connectInterval);
+    parameters.insert(QStringLiteral("updateIntervalMs"), m_parameters.updateInterval);
+    parameters.insert(QStringLiteral("durationMs"), m_parameters.duration);
+
+    QStringList names = m_timings.keys();
+    names.sort();
+
+    QJsonArray sources;
+    QVector<qint64> firstUpdates;
+    QVector<qint64> jitters;
+    int silent = 0;
+    foreach (const QString &name, names) {
+        const SourceTimings timings = m_timings.value(name);
+
+        // the deviation from the requested interval, or from the average one
+        // for sources which update at their own pace
+        qint64 expected = m_parameters.updateInterval * qint64(1000000);
+        if (expected <= 0 && !timings.intervals.isEmpty()) {
+            expected = std::accumulate(timings.intervals.constBegin(), timings.intervals.constEnd(), qint64(0))
+                       / timings.intervals.count();
+        }
+
+        QVector<qint64> sourceJitters;
+        sourceJitters.reserve(timings.intervals.count());
+        foreach (qint64 interval, timings.intervals) {
+            sourceJitters << qAbs(interval - expected);
+        }
+        jitters += sourceJitters;
+
+        const qint64 firstUpdate = timings.firstUpdate >= 0 ? timings.firstUpdate - timings.connected : -1;
+        if (firstUpdate >= 0) {
+            firstUpdates << firstUpdate;
+        } else {
+            ++silent;
+        }
+
+        QJsonObject source;
+        source.insert(QStringLiteral("name"), name);
+        source.insert(QStringLiteral("firstUpdateMs"), milliseconds(firstUpdate));
+        source.insert(QStringLiteral("updates"), timings.firstUpdate >= 0 ? timings.intervals.count() + 1 : 0);
+        source.insert(QStringLiteral("intervalP50Ms"), milliseconds(percentile(timings.intervals, 50)));
+        source.insert(QStringLiteral("jitterP95Ms"), milliseconds(percentile(sourceJitters, 95)));
+        sources << source;
+    }
+
+    const double seconds = m_end > 0 ? m_end / 1000000000.0 : 0;
+
+    QJsonObject summary;
+    summary.insert(QStringLiteral("sourcesWithoutData"), silent);
+    summary.insert(QStringLiteral("firstUpdate"), distribution(firstUpdates));
+    summary.insert(QStringLiteral("jitter"), distribution(jitters));
+    summary.insert(QStringLiteral("updates"), m_updates);
+    summary.insert(QStringLiteral("updatesPerSecond"), seconds > 0 ? std::round(m_updates / seconds * 100) / 100 : 0);
+    summary.insert(QStringLiteral("elapsedMs"), milliseconds(m_end));
+
+    if (m_startMemory >= 0 && m_endMemory >= 0) {
+        summary.insert(QStringLiteral("rssStartKiB"), m_startMemory);
+        summary.insert(QStringLiteral("rssGrowthKiB"), m_endMemory - m_startMemory);
+    } else {
+        summary.insert(QStringLiteral("rssStartKiB"), QJsonValue(QJsonValue::Null));
+        summary.insert(QStringLiteral("rssGrowthKiB"), QJsonValue(QJsonValue::Null));
+    }
+
+    if (m_startCpu >= 0 && m_endCpu >= 0) {
+        const qint64 cpu = m_endCpu - m_startCpu;
+        summary.insert(QStringLiteral("cpuMs"), milliseconds(cpu * 1000));
+        summary.insert(QStringLiteral("cpuPerUpdateUs"), m_updates > 0 ? std::round(double(cpu) / m_updates * 100) / 100 : 0);
+    } else {
+        summary.insert(QStringLiteral("cpuMs"), QJsonValue(QJsonValue::Null));
+        summary.insert(QStringLiteral("cpuPerUpdateUs"), QJsonValue(QJsonValue::Null));
+    }
+
+    QJsonObject report;
+    report.insert(QStringLiteral("version"), s_reportVersion);
+    report.insert(QStringLiteral("engine"), m_parameters.engine);
+    report.insert(QStringLiteral("qtVersion"), QString::fromLatin1(qVersion()));
+    report.insert(QStringLiteral("parameters"), parameters);
+    report.insert(QStringLiteral("sources"), sources);
+    report.insert(QStringLiteral("summary"), summary);
+    return report;
+}
+
+qint64 EngineBenchmark::residentMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+
+    // "VmRSS:	   12345 kB"
+    while (!status.atEnd()) {
+        const QByteArray line = status.readLine();
+        if (line.startsWith("VmRSS:")) {
+            return line.mid(6).simplified().split(' ').value(0).toLongLong();
+        }
+    }
+#endif
+
+    return -1;
+}
+
+qint64 EngineBenchmark::cpuTime()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return (qint64(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000
+               + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    }
+#endif
+
+    return -1;
+}
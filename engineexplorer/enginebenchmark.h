@@ -0,0 +1,108 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef ENGINEBENCHMARK_H
+#define ENGINEBENCHMARK_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+#include <Plasma/DataEngine>
+
+/**
+ * Loads one data engine without any user interface, connects a number of its
+ * sources one after the other and measures how it behaves:
+ *  - the time from connectSource() to the first dataUpdated() of each source
+ *  - how regularly the updates arrive afterwards
+ *  - how much the resident memory grew during the run
+ *  - the CPU time the process spent per update
+ *
+ * The report is a single JSON object. Its keys never change meaning between
+ * versions, so reports of different Plasma releases can be compared; the
+ * "version" key is bumped should that ever become necessary.
+ */
+class EngineBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Parameters {
+        QString engine;
+        QStringList sources;
+        int sourceCount = 0;
+        int connectInterval = 0;
+        int updateInterval = 0;
+        int duration = 10000;
+    };
+
+    explicit EngineBenchmark(QObject *parent = nullptr);
+    ~EngineBenchmark() override;
+
+    /**
+     * Loads the engine and starts connecting its sources.
+     * @return false if the engine could not be loaded or has no sources
+     */
+    bool start(const Parameters &parameters);
+
+    /**
+     * @return the results, once finished() was emitted
+     */
+    QJsonObject report() const;
+
+public Q_SLOTS:
+    void dataUpdated(const QString &source, const Plasma::DataEngine::Data &data);
+
+Q_SIGNALS:
+    void finished(int exitCode);
+
+private Q_SLOTS:
+    void connectNextSource();
+    void stop();
+
+private:
+    struct SourceTimings {
+        qint64 connected = -1;
+        qint64 lastUpdate = -1;
+        qint64 firstUpdate = -1;
+        QVector<qint64> intervals;
+    };
+
+    static qint64 residentMemory();
+    static qint64 cpuTime();
+
+    Parameters m_parameters;
+    Plasma::DataEngine *m_engine;
+    QStringList m_toConnect;
+    QHash<QString, SourceTimings> m_timings;
+    int m_updates;
+    QElapsedTimer m_clock;
+    QTimer m_connectTimer;
+    qint64 m_startMemory;
+    qint64 m_endMemory;
+    qint64 m_startCpu;
+    qint64 m_endCpu;
+    qint64 m_end;
+};
+
+#endif // ENGINEBENCHMARK_H
@@ -0,0 +1,180 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "enginedumper.h"
+
+#include <iostream>
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <KLocalizedString>
+
+#include <Plasma/PluginLoader>
+
+// how long --dump waits for sources which never deliver any data
+static const int s_dumpTimeout = 10000;
+
+EngineDumper::EngineDumper(Mode mode, QObject *parent)
+    : QObject(parent),
+      m_mode(mode),
+      m_engine(nullptr),
+      m_interval(0)
+{
+    m_timeout.setSingleShot(true);
+    m_timeout.setInterval(s_dumpTimeout);
+    connect(&m_timeout, SIGNAL(timeout()), this, SLOT(timedOut()));
+}
+
+EngineDumper::~EngineDumper()
+{
+}
+
+bool EngineDumper::start(const QString &engine, const QStringList &sources, int interval)
+{
+    m_engineName = engine;
+    m_interval = qMax(0, interval);
+    m_engine = Plasma::PluginLoader::self()->loadDataEngine(engine);
+    if (!m_engine || !m_engine->isValid()) {
+        std::cerr << i18n("Could not load the data engine %1", engine).toLocal8Bit().constData() << std::endl;
+        return false;
+    }
+
+    QStringList toConnect = sources;
+    if (toConnect.isEmpty()) {
+        toConnect = m_engine->sources();
+
+        // when following the whole engine, sources showing up later are
+        // interesting as well
+        if (m_mode == Watch) {
+            connect(m_engine, SIGNAL(sourceAdded(QString)), this, SLOT(sourceAdded(QString)));
+        }
+    }
+
+    if (m_mode == Dump) {
+        m_pending = toConnect.toSet();
+        m_timeout.start();
+    }
+
+    foreach (const QString &source, toConnect) {
+        m_engine->connectSource(source, this, m_mode == Watch ? m_interval : 0);
+    }
+
+    checkFinished();
+    return true;
+}
+
+void EngineDumper::dataUpdated(const QString &source, const Plasma::DataEngine::Data &data)
+{
+    if (m_mode == Dump && !m_pending.contains(source)) {
+        return;
+    }
+
+    QJsonObject values;
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
+        values.insert(it.key(), toJson(source % QLatin1Char('\x1f') % it.key(), it.value()));
+    }
+
+    QJsonObject line;
+    line.insert(QStringLiteral("engine"), m_engineName);
+    line.insert(QStringLiteral("source"), source);
+    line.insert(QStringLiteral("timestamp"), QDateTime::currentMSecsSinceEpoch());
+    line.insert(QStringLiteral("data"), values);
+
+    // one object per line, flushed right away so the output can be piped
+    std::cout << QJsonDocument(line).toJson(QJsonDocument::Compact).constData() << std::endl;
+
+    if (m_mode == Dump) {
+        m_pending.remove(source);
+        checkFinished();
+    }
+}
+
+void EngineDumper::sourceAdded(const QString &source)
+{
+    m_engine->connectSource(source, this, m_interval);
+}
+
+void EngineDumper::timedOut()
+{
+    foreach (const QString &source, m_pending) {
+        std::cerr << i18n("No data received for source %1", source).toLocal8Bit().constData() << std::endl;
+    }
+
+    m_pending.clear();
+    emit finished(1);
+}
+
+void EngineDumper::checkFinished()
+{
+    if (m_mode == Dump && m_pending.isEmpty() && m_timeout.isActive()) {
+        m_timeout.stop();
+        emit finished(0);
+    }
+}
+
+QJsonValue EngineDumper::toJson(const QString &slot, const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::UnknownType:
+        return QJsonValue();
+    case QMetaType::Bool:
+        return value.toBool();
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return value.toDouble();
+    case QMetaType::QString:
+    case QMetaType::QChar:
+        return value.toString();
+    case QMetaType::QStringList:
+        return QJsonArray::fromStringList(value.toStringList());
+    case QMetaType::QVariantList: {
+        QJsonArray array;
+        const QVariantList list = value.toList();
+        for (int i = 0; i < list.count(); ++i) {
+            array.append(toJson(slot % QLatin1Char('\x1f') % QString::number(i), list.at(i)));
+        }
+        return array;
+    }
+    case QMetaType::QVariantMap: {
+        QJsonObject object;
+        const QVariantMap map = value.toMap();
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            object.insert(it.key(), toJson(slot % QLatin1Char('\x1f') % it.key(), it.value()));
+        }
+        return object;
+    }
+    case QMetaType::QVariantHash: {
+        QJsonObject object;
+        const QVariantHash hash = value.toHash();
+        for (auto it = hash.constBegin(); it != hash.constEnd(); ++it) {
+            object.insert(it.key(), toJson(slot % QLatin1Char('\x1f') % it.key(), it.value()));
+        }
+        return object;
+    }
+    default:
+        return m_formatter.cachedFormat(slot, value);
+    }
+}
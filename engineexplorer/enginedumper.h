@@ -0,0 +1,86 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef ENGINEDUMPER_H
+#define ENGINEDUMPER_H
+
+#include <QJsonValue>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+
+#include <Plasma/DataEngine>
+
+#include "valueformatter.h"
+
+/**
+ * Writes the data of the sources of one data engine to stdout, one JSON
+ * object per line, without any user interface.
+ *
+ * In Dump mode every source is written once and finished() is emitted as soon
+ * as all of them delivered data. In Watch mode every update is written until
+ * the process is stopped.
+ *
+ * Values JSON can represent, lists and maps included, are written as JSON;
+ * the others, e.g. images or rects, as the text the explorer shows for them.
+ */
+class EngineDumper : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Mode {
+        Dump,
+        Watch
+    };
+
+    explicit EngineDumper(Mode mode, QObject *parent = nullptr);
+    ~EngineDumper() override;
+
+    /**
+     * Loads @p engine and connects to @p sources, or to all the sources the
+     * engine publishes if the list is empty.
+     * @return false if the engine could not be loaded
+     */
+    bool start(const QString &engine, const QStringList &sources, int interval);
+
+public Q_SLOTS:
+    void dataUpdated(const QString &source, const Plasma::DataEngine::Data &data);
+
+Q_SIGNALS:
+    void finished(int exitCode);
+
+private Q_SLOTS:
+    void sourceAdded(const QString &source);
+    void timedOut();
+
+private:
+    void checkFinished();
+    QJsonValue toJson(const QString &slot, const QVariant &value);
+
+    Mode m_mode;
+    Plasma::DataEngine *m_engine;
+    QString m_engineName;
+    int m_interval;
+    QSet<QString> m_pending;
+    QTimer m_timeout;
+    ValueFormatter m_formatter;
+};
+
+#endif // ENGINEDUMPER_H
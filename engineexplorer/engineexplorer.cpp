@@ -21,8 +21,6 @@
 
 #include <QApplication>
 #include <QStandardItemModel>
-#include <QBitmap>
-#include <QBitArray>
 #include <QDialogButtonBox>
 #include <QMenu>
 #include <QUrl>
@@ -37,31 +35,26 @@
 
 #include <Plasma/PluginLoader>
 
-#ifdef FOUND_SOPRANO
-#include <Soprano/Node>
-Q_DECLARE_METATYPE(Soprano::Node)
-#endif // FOUND_SOPRANO
-Q_DECLARE_METATYPE(Plasma::DataEngine::Data)
-
 #include "modelviewer.h"
 #include "serviceviewer.h"
 #include "titlecombobox.h"
+#include "updatecoalescer.h"
+#include "valueformatter.h"
 
 EngineExplorer::EngineExplorer(QWidget* parent)
     : QDialog(parent),
       m_engine(nullptr),
-      m_sourceCount(0),
       m_requestingSource(false),
+      m_attachButton(new QPushButton(i18n("Attach Engine"), this)),
       m_expandButton(new QPushButton(i18n("Expand All"), this)),
-      m_collapseButton(new QPushButton(i18n("Collapse All"), this))
+      m_collapseButton(new QPushButton(i18n("Collapse All"), this)),
+      m_coalescer(new UpdateCoalescer(this))
 {
-#ifdef FOUND_SOPRANO
-    (void) qRegisterMetaType<Soprano::Node>();
-#endif
     setWindowTitle(i18n("Plasma Engine Explorer"));
     QWidget* mainWidget = new QWidget(this);
 
     QDialogButtonBox *buttonBox = new QDialogButtonBox(this);
+    buttonBox->addButton(m_attachButton, QDialogButtonBox::ActionRole);
     buttonBox->addButton(m_expandButton, QDialogButtonBox::ActionRole);
     buttonBox->addButton(m_collapseButton, QDialogButtonBox::ActionRole);
     buttonBox->addButton(QDialogButtonBox::Close);
@@ -77,12 +70,18 @@ EngineExplorer::EngineExplorer(QWidget* parent)
 
     m_engineManager = Plasma::PluginLoader::self();
     m_dataModel = new QStandardItemModel(this);
+    m_dataModel->setColumnCount(4);
+    QStringList headers;
+    headers << i18n("DataSource") << i18n("Key") << i18n("Value") << i18n("Type");
+    m_dataModel->setHorizontalHeaderLabels(headers);
     const QIcon pix = QIcon::fromTheme("plasma");
     const int size = IconSize(KIconLoader::Dialog);
     m_title->setPixmap(pix.pixmap(size, size));
     connect(m_engines, SIGNAL(activated(QString)), this, SLOT(showEngine(QString)));
     connect(m_sourceRequesterButton, SIGNAL(clicked(bool)), this, SLOT(requestSource()));
     connect(m_serviceRequesterButton, SIGNAL(clicked(bool)), this, SLOT(requestServiceForSource()));
+    connect(m_coalescer, SIGNAL(dataReady(QString,QString,Plasma::DataEngine::Data)),
+            this, SLOT(showUpdate(QString,QString,Plasma::DataEngine::Data)));
     m_data->setModel(m_dataModel);
     m_data->setWordWrap(true);
 
@@ -92,8 +91,14 @@ EngineExplorer::EngineExplorer(QWidget* parent)
     listEngines();
     m_engines->setFocus();
 
+    QMenu *attachMenu = new QMenu(m_attachButton);
+    m_attachButton->setMenu(attachMenu);
+    connect(attachMenu, SIGNAL(aboutToShow()), this, SLOT(updateAttachMenu()));
+    connect(attachMenu, SIGNAL(triggered(QAction*)), this, SLOT(attachEngineFromMenu(QAction*)));
+
     connect(m_collapseButton, SIGNAL(clicked()), m_data, SLOT(collapseAll()));
-    connect(m_expandButton, SIGNAL(clicked()), m_data, SLOT(expandAll()));
+    connect(m_expandButton, SIGNAL(clicked()), this, SLOT(expandSources()));
+    connect(m_data, SIGNAL(expanded(QModelIndex)), this, SLOT(populateIndex(QModelIndex)));
     enableButtons(false);
 
     addAction(KStandardAction::quit(qApp, SLOT(quit()), this));
@@ -110,8 +115,8 @@ EngineExplorer::~EngineExplorer()
 
 void EngineExplorer::cleanUp()
 {
-    if (!m_engineName.isEmpty()) {
-        //m_engineManager->unloadEngine(m_engineName);
+    foreach (const QString &engine, m_attached.keys()) {
+        detachEngine(engine);
     }
 }
 
@@ -140,20 +145,22 @@ void EngineExplorer::setInterval(const int interval)
     m_updateInterval->setValue(interval);
 }
 
-void EngineExplorer::dataUpdated(const QString& source, const Plasma::DataEngine::Data& data)
+void EngineExplorer::showUpdate(const QString &engine, const QString &source, const Plasma::DataEngine::Data &data)
 {
-    QList<QStandardItem*> items = m_dataModel->findItems(source, nullptr);
-
-    if (items.isEmpty()) {
+    auto it = m_attached.constFind(engine);
+    if (it == m_attached.constEnd()) {
         return;
     }
 
-    QStandardItem* parent = items.first();
+    QStandardItem* parent = it->sources.value(source);
+    if (!parent) {
+        return;
+    }
 
-    int rows = showData(parent, data);
+    const int rows = showData(parent, engine % QLatin1Char('\x1f') % source, data);
 
-    while (parent->rowCount() > rows) {
-        parent->removeRow(rows);
+    if (parent->rowCount() > rows) {
+        parent->removeRows(rows, parent->rowCount() - rows);
     }
 }
 
@@ -172,21 +179,13 @@ void EngineExplorer::listEngines()
 
 void EngineExplorer::showEngine(const QString& name)
 {
-    m_sourceRequester->setEnabled(false);
-    m_sourceRequesterButton->setEnabled(false);
-    m_serviceRequester->setEnabled(false);
-    m_serviceRequesterButton->setEnabled(false);
+    enableRequesters(false);
     enableButtons(false);
-    m_dataModel->clear();
-    m_dataModel->setColumnCount(4);
-    QStringList headers;
-    headers << i18n("DataSource") << i18n("Key") << i18n("Value") << i18n("Type");
-    m_dataModel->setHorizontalHeaderLabels(headers);
-    m_engine = nullptr;
-    m_sourceCount = 0;
 
-    if (!m_engineName.isEmpty()) {
-        //m_engineManager->unloadEngine(m_engineName);
+    m_engine = nullptr;
+    m_engineName.clear();
+    foreach (const QString &engine, m_attached.keys()) {
+        detachEngine(engine);
     }
 
     m_engineName = name;
@@ -195,69 +194,136 @@ void EngineExplorer::showEngine(const QString& name)
         return;
     }
 
-    m_engine = m_engineManager->loadDataEngine(m_engineName);
+    m_engine = attachEngine(m_engineName);
     if (!m_engine) {
         m_engineName.clear();
         updateTitle();
         return;
     }
 
-    //qDebug() << "showing engine " << m_engine->objectName();
-    //qDebug() << "we have " << sources.count() << " data sources";
-    connect(m_engine, SIGNAL(sourceAdded(QString)), this, SLOT(addSource(QString)));
-    connect(m_engine, SIGNAL(sourceRemoved(QString)), this, SLOT(removeSource(QString)));
-    foreach (const QString& source, m_engine->sources()) {
+    enableRequesters(true);
+    m_sourceRequester->setFocus();
+    updateTitle();
+}
+
+Plasma::DataEngine *EngineExplorer::attachEngine(const QString &name)
+{
+    if (m_attached.contains(name)) {
+        return m_attached.value(name).engine;
+    }
+
+    Plasma::DataEngine *engine = m_engineManager->loadDataEngine(name);
+    if (!engine) {
+        return nullptr;
+    }
+
+    AttachedEngine attached;
+    attached.engine = engine;
+    attached.item = new QStandardItem(QIcon::fromTheme(engine->pluginInfo().icon()), name);
+    m_dataModel->appendRow(attached.item);
+    m_attached.insert(name, attached);
+
+    //qDebug() << "showing engine " << engine->objectName();
+    connect(engine, &Plasma::DataEngine::sourceAdded, this, [this, name](const QString &source) {
+        addSource(name, source);
+    });
+    connect(engine, &Plasma::DataEngine::sourceRemoved, this, [this, name](const QString &source) {
+        removeSource(name, source);
+    });
+    foreach (const QString& source, engine->sources()) {
         //qDebug() << "adding " << source;
-        addSource(source);
+        addSource(name, source);
     }
 
-    m_sourceRequesterButton->setEnabled(true);
-    m_updateInterval->setEnabled(true);
-    m_sourceRequester->setEnabled(true);
-    m_sourceRequester->setFocus();
-    m_serviceRequester->setEnabled(true);
-    m_serviceRequesterButton->setEnabled(true);
+    m_data->expand(attached.item->index());
+    updateTitle();
+    return engine;
+}
+
+void EngineExplorer::attachEngineFromMenu(QAction *action)
+{
+    attachEngine(action->data().toString());
+}
+
+void EngineExplorer::detachEngine(const QString &name)
+{
+    const AttachedEngine attached = m_attached.take(name);
+    if (!attached.engine) {
+        return;
+    }
+
+    disconnect(attached.engine, nullptr, this, nullptr);
+    QObject *receiver = m_coalescer->receiverFor(name);
+    foreach (const QString &source, attached.sources.keys()) {
+        attached.engine->disconnectSource(source, receiver);
+    }
+    m_coalescer->removeReceiver(name);
+    m_dataModel->removeRow(attached.item->row());
+    //m_engineManager->unloadEngine(name);
+
+    if (name == m_engineName) {
+        m_engine = nullptr;
+        m_engineName.clear();
+        m_engines->setCurrentIndex(-1);
+        enableRequesters(false);
+    }
+
+    enableButtons(m_dataModel->rowCount() > 0);
     updateTitle();
 }
 
-void EngineExplorer::addSource(const QString& source)
+void EngineExplorer::updateAttachMenu()
+{
+    QMenu *menu = m_attachButton->menu();
+    menu->clear();
+
+    for (int i = 0; i < m_engines->count(); ++i) {
+        const QString name = m_engines->itemText(i);
+        QAction *action = menu->addAction(m_engines->itemIcon(i), name);
+        action->setData(name);
+        action->setEnabled(!m_attached.contains(name));
+    }
+}
+
+void EngineExplorer::addSource(const QString &engine, const QString& source)
 {
     //qDebug() << "adding" << source;
-    QList<QStandardItem*> items = m_dataModel->findItems(source, nullptr);
-    if (!items.isEmpty()) {
+    auto it = m_attached.find(engine);
+    if (it == m_attached.end() || it->sources.contains(source)) {
         //qDebug() << "er... already there?";
         return;
     }
 
     QStandardItem* parent = new QStandardItem(source);
-    m_dataModel->appendRow(parent);
+    it->item->appendRow(parent);
+    it->sources.insert(source, parent);
 
     //qDebug() << "getting data for source " << source;
-    if (!m_requestingSource || m_sourceRequester->text() != source) {
+    if (!m_requestingSource || engine != m_engineName || m_sourceRequester->text() != source) {
         //qDebug() << "connecting up now";
-        m_engine->connectSource(source, this);
+        it->engine->connectSource(source, m_coalescer->receiverFor(engine));
     }
 
-    ++m_sourceCount;
     updateTitle();
 
     enableButtons(true);
 }
 
-void EngineExplorer::removeSource(const QString& source)
+void EngineExplorer::removeSource(const QString &engine, const QString& source)
 {
-    QList<QStandardItem*> items = m_dataModel->findItems(source, nullptr);
-
-    if (items.count() < 1) {
+    auto it = m_attached.find(engine);
+    if (it == m_attached.end()) {
         return;
     }
 
-    foreach (QStandardItem* item, items) {
-        m_dataModel->removeRow(item->row());
+    QStandardItem *item = it->sources.take(source);
+    if (!item) {
+        return;
     }
 
-    --m_sourceCount;
-    m_engine->disconnectSource(source, this);
+    it->item->removeRow(item->row());
+    it->engine->disconnectSource(source, m_coalescer->receiverFor(engine));
+    m_coalescer->drop(engine, source);
     updateTitle();
 }
 
@@ -280,224 +346,184 @@ void EngineExplorer::requestSource(const QString &source)
 
     qDebug() << "request source" << source;
     m_requestingSource = true;
-    m_engine->connectSource(source, this, (uint)m_updateInterval->value());
+    m_engine->connectSource(source, m_coalescer->receiverFor(m_engineName), (uint)m_updateInterval->value());
     m_requestingSource = false;
 }
 
 void EngineExplorer::showDataContextMenu(const QPoint &point)
 {
     QModelIndex index = m_data->indexAt(point);
-    if (index.isValid()) {
-        if (index.parent().isValid()) {
-            index = index.parent();
-        }
+    if (!index.isValid()) {
+        return;
+    }
 
-        if (index.column() != 0) {
-            index = m_dataModel->index(index.row(), 0);
-        }
+    // walk up to the engine, remembering the source right below it
+    index = index.sibling(index.row(), 0);
+    QModelIndex sourceIndex;
+    while (index.parent().isValid()) {
+        sourceIndex = index;
+        index = index.parent();
+    }
+
+    const QString engineName = index.data().toString();
+    Plasma::DataEngine *engine = m_attached.value(engineName).engine;
+    if (!engine) {
+        return;
+    }
 
-        const QString source = index.data().toString();
-        QMenu menu;
-        menu.addSection(source);
-        QAction *service = menu.addAction(i18n("Get associated service"));
-        QAction *model = menu.addAction(i18n("Get associated model"));
-        QAction *update = menu.addAction(i18n("Update source now"));
-        QAction *remove = menu.addAction(i18n("Remove source"));
-
-        QAction *activated = menu.exec(m_data->viewport()->mapToGlobal(point));
-        if (activated == service) {
-            ServiceViewer *viewer = new ServiceViewer(m_engine, source);
-            viewer->show();
-        } else if (activated == model) {
-            ModelViewer *viewer = new ModelViewer(m_engine, source);
-            viewer->show();
-        } else if (activated == update) {
-            m_engine->connectSource(source, this);
-            //Plasma::DataEngine::Data data = m_engine->query(source);
-        } else if (activated == remove) {
-            removeSource(source);
+    QMenu menu;
+    if (!sourceIndex.isValid()) {
+        menu.addSection(engineName);
+        QAction *detach = menu.addAction(i18n("Detach engine"));
+
+        if (menu.exec(m_data->viewport()->mapToGlobal(point)) == detach) {
+            detachEngine(engineName);
         }
+        return;
+    }
+
+    const QString source = sourceIndex.data().toString();
+    menu.addSection(source);
+    QAction *service = menu.addAction(i18n("Get associated service"));
+    QAction *model = menu.addAction(i18n("Get associated model"));
+    QAction *update = menu.addAction(i18n("Update source now"));
+    QAction *remove = menu.addAction(i18n("Remove source"));
+
+    QAction *activated = menu.exec(m_data->viewport()->mapToGlobal(point));
+    if (activated == service) {
+        ServiceViewer *viewer = new ServiceViewer(engine, source);
+        viewer->show();
+    } else if (activated == model) {
+        ModelViewer *viewer = new ModelViewer(engine, source);
+        viewer->show();
+    } else if (activated == update) {
+        engine->connectSource(source, m_coalescer->receiverFor(engineName));
+        //Plasma::DataEngine::Data data = engine->query(source);
+    } else if (activated == remove) {
+        removeSource(engineName, source);
     }
 }
 
 QString EngineExplorer::convertToString(const QVariant &value)
 {
-    switch (value.type())
-    {
-        case QVariant::BitArray: {
-            return i18np("<1 bit>", "<%1 bits>", value.toBitArray().size());
-        }
-        case QVariant::Bitmap: {
-            QBitmap bitmap = value.value<QBitmap>();
-            return QString("<%1x%2px - %3bpp>").arg(bitmap.width()).arg(bitmap.height()).arg(bitmap.depth());
+    return ValueFormatter::format(value);
+}
+
+int EngineExplorer::showData(QStandardItem* parent, const QString &slot, const Plasma::DataEngine::Data &data)
+{
+    int rowCount = 0;
+    Plasma::DataEngine::DataIterator it(data);
+    while (it.hasNext()) {
+        it.next();
+        showValue(parent, rowCount, slot % QLatin1Char('\x1f') % it.key(), it.key(), it.value());
+        ++rowCount;
+    }
+
+    return rowCount;
+}
+
+void EngineExplorer::showValue(QStandardItem *parent, int row, const QString &slot, const QString &key, const QVariant &value)
+{
+    QStandardItem *holder = parent->child(row, 0);
+    if (!holder) {
+        holder = new QStandardItem();
+        parent->setChild(row, 0, holder);
+    }
+
+    setChildText(parent, row, 1, key);
+    setChildText(parent, row, 3, QString::fromLatin1(value.typeName()));
+
+    const bool container = ValueFormatter::isContainer(value);
+    if (!container && value.canConvert<QIcon>()) {
+        QStandardItem *item = new QStandardItem(value.value<QIcon>(), QString());
+        parent->setChild(row, 2, item);
+    } else {
+        bool changed = true;
+        const QString text = m_formatter.cachedSummary(slot, value, &changed);
+        QStandardItem *item = parent->child(row, 2);
+        if (!item || !item->icon().isNull()) {
+            item = new QStandardItem(text);
+            item->setToolTip(text);
+            parent->setChild(row, 2, item);
+        } else if (item->text() != text) {
+            item->setText(text);
+            item->setToolTip(text);
         }
-        case QVariant::ByteArray: {
-            // Return the array size if it is not displayable
-            if (value.toString().isEmpty()) {
-                return i18np("<1 byte>", "<%1 bytes>", value.toByteArray().size());
-            }
-            else {
-                return value.toString();
+
+        if (container && (changed || holder->data(SlotRole).toString() != slot)) {
+            // the children are only built once the user expands the row,
+            // until then a placeholder child makes the row expandable
+            holder->removeRows(0, holder->rowCount());
+            holder->setData(value, ValueRole);
+            holder->setData(slot, SlotRole);
+            holder->setData(false, PopulatedRole);
+            holder->appendRow(new QStandardItem());
+
+            if (m_data->isExpanded(holder->index())) {
+                populateItem(holder);
             }
         }
-        case QVariant::Image: {
-            QImage image = value.value<QImage>();
-            return QString("<%1x%2px - %3bpp>").arg(image.width()).arg(image.height()).arg(image.depth());
-        }
-        case QVariant::Line: {
-           QLine line = value.toLine();
-           return QString("<x1:%1, y1:%2, x2:%3, y2:%4>").arg(line.x1()).arg(line.y1()).arg(line.x2()).arg(line.y2());
-        }
-        case QVariant::LineF: {
-           QLineF lineF = value.toLineF();
-           return QString("<x1:%1, y1:%2, x2:%3, y2:%4>").arg(lineF.x1()).arg(lineF.y1()).arg(lineF.x2()).arg(lineF.y2());
-        }
-        case QVariant::Locale: {
-            return QString("%1").arg(value.toLocale().name());
-        }
-        case QVariant::Map: {
-            QVariantMap map = value.toMap();
-            QString str = i18np("<1 item>", "<%1 items>", map.size());
-
-            QMapIterator<QString, QVariant> it(map);
-            while (it.hasNext()) {
-                it.next();
-                str += "\n" + it.key() + ": " + convertToString(it.value());
-            }
+    }
 
-            return str;
-        }
-        case QVariant::Pixmap: {
-            QPixmap pixmap = value.value<QPixmap>();
-            return QString("<%1x%2px - %3bpp>").arg(pixmap.width()).arg(pixmap.height()).arg(pixmap.depth());
-        }
-        case QVariant::Point: {
-           QPoint point = value.toPoint();
-           return QString("<x:%1, y:%2>").arg(point.x()).arg(point.y());
-        }
-        case QVariant::PointF: {
-           QPointF pointF = value.toPointF();
-           return QString("<x:%1, y:%2>").arg(pointF.x()).arg(pointF.y());
-        }
-        case QVariant::Rect: {
-            QRect rect = value.toRect();
-            return QString("<x:%1, y:%2, w:%3, h:%4>").arg(rect.x()).arg(rect.y()).arg(rect.width()).arg(rect.height());
-        }
-        case QVariant::RectF: {
-            QRectF rectF = value.toRectF();
-            return QString("<x:%1, y:%2, w:%3, h:%4>").arg(rectF.x()).arg(rectF.y()).arg(rectF.width()).arg(rectF.height());
-        }
-        case QVariant::RegExp: {
-            return QString("%1").arg(value.toRegExp().pattern());
-        }
-        case QVariant::Region: {
-            QRect region = value.value<QRegion>().boundingRect();
-            return QString("<x:%1, y:%2, w:%3, h:%4>").arg(region.x()).arg(region.y()).arg(region.width()).arg(region.height());
-        }
-        case QVariant::Size: {
-            QSize size = value.toSize();
-            return QString("<w:%1, h:%2>").arg(size.width()).arg(size.height());
-        }
-        case QVariant::SizeF: {
-            QSizeF sizeF = value.toSizeF();
-            return QString("<w:%1, h:%2>").arg(sizeF.width()).arg(sizeF.height());
-        }
-        case QVariant::Url: {
-            return QString("%1").arg(value.toUrl().toString());
-        }
-        case QVariant::StringList: {
-            return QString("%1").arg(value.toStringList().join(", "));
-        }
-        case QVariant::Date: {
-            return QString("%1").arg(value.toDate().toString());
-        }
-        case QVariant::DateTime: {
-            return QString("%1").arg(value.toDateTime().toString());
-        }
-        case QVariant::Time: {
-            return QString("%1").arg(value.toTime().toString());
-        }
-        default: {
-#ifdef FOUND_SOPRANO
-            if (QLatin1String(value.typeName()) == "Soprano::Node") {
-                Soprano::Node node = value.value<Soprano::Node>();
-                if (node.isLiteral()) {
-                    return convertToString(node.literal().variant());
-                } else if (node.isResource()) {
-                    return node.uri().toString();
-                } else if (node.isBlank()) {
-                    return QString("_:%1").arg(node.identifier());
-                }
-            }
-#endif
-            if (QLatin1String(value.typeName()) == "QDateTime") {
-                return QString("%1").arg(value.value<QDateTime>().toString());
-            }
+    if (!container && holder->data(ValueRole).isValid()) {
+        holder->removeRows(0, holder->rowCount());
+        holder->setData(QVariant(), ValueRole);
+        holder->setData(QVariant(), SlotRole);
+        holder->setData(QVariant(), PopulatedRole);
+    }
+}
 
-            Plasma::DataEngine::Data data = value.value<Plasma::DataEngine::Data>();
-            if (!data.isEmpty()) {
-                QStringList result;
-                QMapIterator<QString, QVariant> it(data);
-
-                while (it.hasNext()) {
-                    it.next();
-                    result << (it.key() + ": " + convertToString(it.value()));
-                }
-
-                return result.join("\n");
-            } else if (value.canConvert(QVariant::String)) {
-                if (value.toString().isEmpty()) {
-                    return i18nc("The user did a query to a dataengine and it returned empty data", "<empty>");
-                }
-                else {
-                    return value.toString();
-                }
-            }
+void EngineExplorer::setChildText(QStandardItem *parent, int row, int column, const QString &text)
+{
+    QStandardItem *item = parent->child(row, column);
+    if (!item) {
+        parent->setChild(row, column, new QStandardItem(text));
+    } else if (item->text() != text) {
+        item->setText(text);
+    }
+}
 
-            return i18nc("A the dataengine returned something that the humble view on the engineexplorer can't display, like a picture", "<not displayable>");
-        }
+void EngineExplorer::populateIndex(const QModelIndex &index)
+{
+    QStandardItem *holder = m_dataModel->itemFromIndex(index.sibling(index.row(), 0));
+    if (holder && holder->data(ValueRole).isValid()) {
+        populateItem(holder);
     }
 }
 
-int EngineExplorer::showData(QStandardItem* parent, Plasma::DataEngine::Data data)
+void EngineExplorer::populateItem(QStandardItem *holder)
 {
-    int rowCount = 0;
-    Plasma::DataEngine::DataIterator it(data);
-//    parent->insertRows(0, data.count());
-//    parent->setColumnCount(3);
-    while (it.hasNext()) {
-        it.next();
-        parent->setChild(rowCount, 1, new QStandardItem(it.key()));
-        if (it.value().canConvert(QVariant::List) /* && ! it.value().type() == QVariant::StringList
-                                                     */) {
-            bool first = true;
-            foreach (const QVariant &var, it.value().toList()) {
-                QStandardItem *item = new QStandardItem(convertToString(var));
-                if (!first) {
-                    parent->setChild(rowCount, 1, new QStandardItem(QString()));
-                }
-                item->setToolTip(item->text());
-                parent->setChild(rowCount, 2, item);
-                parent->setChild(rowCount, 3, new QStandardItem(var.typeName()));
-                first = false;
-                ++rowCount;
-            }
-        } else {
-            QStandardItem *item;
-            if (it.value().canConvert<QIcon>()) {
-                item = new QStandardItem(it.value().value<QIcon>(), "");
-            } else {
-                item = new QStandardItem(convertToString(it.value()));
-            }
+    if (holder->data(PopulatedRole).toBool()) {
+        return;
+    }
+
+    const QVariant value = holder->data(ValueRole);
+    const QString slot = holder->data(SlotRole).toString();
+    holder->removeRows(0, holder->rowCount());
 
-            item->setToolTip(item->text());
-            parent->setChild(rowCount, 2, item);
-            parent->setChild(rowCount, 3, new QStandardItem(it.value().typeName()));
-            ++rowCount;
+    int row = 0;
+    if (value.canConvert(QVariant::List)) {
+        foreach (const QVariant &var, value.toList()) {
+            const QString key = QString::number(row);
+            showValue(holder, row, slot % QLatin1Char('\x1f') % key, key, var);
+            ++row;
+        }
+    } else {
+        const QVariantMap map = value.toMap();
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            showValue(holder, row, slot % QLatin1Char('\x1f') % it.key(), it.key(), it.value());
+            ++row;
         }
     }
 
-    return rowCount;
+    holder->setData(true, PopulatedRole);
+}
+
+void EngineExplorer::expandSources()
+{
+    // expandAll() would also open every nested list and map, building all
+    // the rows the lazy expansion is there to avoid
+    m_data->expandToDepth(1);
 }
 
 void EngineExplorer::updateTitle()
@@ -511,7 +537,7 @@ void EngineExplorer::updateTitle()
     m_title->setText(ki18ncp("The name of the engine followed by the number of data sources",
                              "%1 Engine - 1 data source", "%1 Engine - %2 data sources")
                               .subs(KStringHandler::capwords(m_engine->pluginInfo().name()))
-                              .subs(m_sourceCount).toString());
+                              .subs(m_attached.value(m_engineName).sources.count()).toString());
 
     if (m_engine->pluginInfo().icon().isEmpty()) {
         m_title->setPixmap(QIcon::fromTheme("plasma").pixmap(IconSize(KIconLoader::Dialog)));
@@ -521,6 +547,15 @@ void EngineExplorer::updateTitle()
     }
 }
 
+void EngineExplorer::enableRequesters(bool enable)
+{
+    m_sourceRequester->setEnabled(enable);
+    m_sourceRequesterButton->setEnabled(enable);
+    m_updateInterval->setEnabled(enable);
+    m_serviceRequester->setEnabled(enable);
+    m_serviceRequesterButton->setEnabled(enable);
+}
+
 void EngineExplorer::enableButtons(bool enable)
 {
     if (m_expandButton) {
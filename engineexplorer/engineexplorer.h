@@ -28,6 +28,7 @@ class QStandardItem;
 #include <Plasma/DataEngine>
 
 #include "ui_engineexplorer.h"
+#include "valueformatter.h"
 
 namespace Plasma
 {
@@ -36,7 +37,9 @@ namespace Plasma
     class PluginLoader;
 } // namespace Plasma
 
+class QAction;
 class QPushButton;
+class UpdateCoalescer;
 
 class EngineExplorer : public QDialog, public Ui::EngineExplorer
 {
@@ -51,24 +54,49 @@ class EngineExplorer : public QDialog, public Ui::EngineExplorer
         void setInterval(const int interval);
         void requestSource(const QString &source);
 
-        static QString convertToString(const QVariant &value);
+        /**
+         * Shows @p engine next to the engines already in the view, all of
+         * them sharing the same model, formatter cache and update coalescer.
+         */
+        Plasma::DataEngine *attachEngine(const QString &engine);
+        void detachEngine(const QString &engine);
 
-    public Q_SLOTS:
-        void dataUpdated(const QString& source, const Plasma::DataEngine::Data& data);
+        static QString convertToString(const QVariant &value);
 
     private Q_SLOTS:
+        void showUpdate(const QString &engine, const QString &source, const Plasma::DataEngine::Data &data);
         void showEngine(const QString& engine);
-        void addSource(const QString& source);
-        void removeSource(const QString& source);
+        void attachEngineFromMenu(QAction *action);
+        void updateAttachMenu();
         void requestSource();
         void requestServiceForSource();
         void showDataContextMenu(const QPoint &point);
         void cleanUp();
+        void expandSources();
+        void populateIndex(const QModelIndex &index);
 
     private:
+        enum ItemRoles {
+            ValueRole = Qt::UserRole + 1,
+            SlotRole,
+            PopulatedRole
+        };
+
+        struct AttachedEngine {
+            Plasma::DataEngine *engine = nullptr;
+            QStandardItem *item = nullptr;
+            QHash<QString, QStandardItem *> sources;
+        };
+
         void listEngines();
-        int showData(QStandardItem* parent, Plasma::DataEngine::Data data);
+        void addSource(const QString &engine, const QString& source);
+        void removeSource(const QString &engine, const QString& source);
+        int showData(QStandardItem* parent, const QString &slot, const Plasma::DataEngine::Data &data);
+        void showValue(QStandardItem *parent, int row, const QString &slot, const QString &key, const QVariant &value);
+        void setChildText(QStandardItem *parent, int row, int column, const QString &text);
+        void populateItem(QStandardItem *holder);
         void updateTitle();
+        void enableRequesters(bool enable);
         void enableButtons(bool enable);
 
         Plasma::PluginLoader* m_engineManager;
@@ -76,10 +104,13 @@ class EngineExplorer : public QDialog, public Ui::EngineExplorer
         QString m_app;
         QString m_engineName;
         Plasma::DataEngine* m_engine;
-        int m_sourceCount;
+        QHash<QString, AttachedEngine> m_attached;
         bool m_requestingSource;
+        QPushButton *m_attachButton;
         QPushButton *m_expandButton;
         QPushButton *m_collapseButton;
+        UpdateCoalescer *m_coalescer;
+        ValueFormatter m_formatter;
 };
 
 #endif // multiple inclusion guard
@@ -20,6 +20,7 @@
 #include <iostream>
 
 #include <QApplication>
+#include <QScopedPointer>
 #include <KAboutData>
 #include <KLocalizedString>
 
@@ -27,7 +28,10 @@
 #include <qcommandlineparser.h>
 #include <qcommandlineoption.h>
 
+#include "enginedumper.h"
 #include "engineexplorer.h"
+#include "modelviewer.h"
+#include "stressmodel.h"
 
 void listEngines()
 {
@@ -61,9 +65,28 @@ void listEngines()
     }
 }
 
+static bool isHeadless(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        const QByteArray arg(argv[i]);
+        if (arg == "--dump" || arg == "--watch") {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 int main(int argc, char **argv)
 {
-    QApplication app(argc, argv);
+    // the application object has to exist before the command line is parsed,
+    // so the GUI-less modes are looked up by hand
+    const bool headless = isHeadless(argc, argv);
+    if (headless && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QScopedPointer<QGuiApplication> app(headless ? new QGuiApplication(argc, argv) : new QApplication(argc, argv));
 
     KLocalizedString::setApplicationDomain("plasmaengineexplorer");
 
@@ -74,7 +97,7 @@ int main(int argc, char **argv)
     aboutData.addAuthor(i18n("Aaron J. Seigo"),
                         i18n( "Author and maintainer" ),
                         "aseigo@kde.org");
-    QApplication::setWindowIcon(QIcon::fromTheme(QStringLiteral("plasma"), app.windowIcon()));
+    QGuiApplication::setWindowIcon(QIcon::fromTheme(QStringLiteral("plasma"), app->windowIcon()));
 
     KAboutData::setApplicationData(aboutData);
 
@@ -85,14 +108,18 @@ int main(int argc, char **argv)
     parser.addOption(QCommandLineOption(QStringList() << "width", i18n("The desired width in pixels"), "pixels"));
     parser.addOption(QCommandLineOption(QStringList() << "x", i18n("The desired x position in pixels"), "pixels"));
     parser.addOption(QCommandLineOption(QStringList() << "y", i18n("The desired y position in pixels"), "pixels"));
-    parser.addOption(QCommandLineOption(QStringList() << "engine", i18n("The data engine to use"), "data engine"));
+    parser.addOption(QCommandLineOption(QStringList() << "engine", i18n("The data engine to use, can be given more than once"), "data engine"));
     parser.addOption(QCommandLineOption(QStringList() << "source", i18n("The source to request"), "data engine"));
     parser.addOption(QCommandLineOption(QStringList() << "interval", i18n("Update interval in milliseconds"), "ms"));
+    parser.addOption(QCommandLineOption(QStringList() << "dump", i18n("Print the data of the sources as JSON lines and exit, without showing a window")));
+    parser.addOption(QCommandLineOption(QStringList() << "watch", i18n("Print every update of the sources as JSON lines, without showing a window")));
+    parser.addOption(QCommandLineOption(QStringList() << "stress-model", i18n("Instead of the engine explorer, open the model viewer on a synthetic model "
+                                           "changing the given number of times per second"), "changes"));
     parser.addOption(QCommandLineOption(QStringList() << "app", i18n("Only show engines associated with the parent application; "
                                            "maps to the X-KDE-ParentApp entry in the DataEngine's .desktop file."), "application"));
 
 
-    parser.process(app);
+    parser.process(*app);
     aboutData.processCommandLine(&parser);
 
     if (parser.isSet("list")) {
@@ -100,9 +127,38 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    bool ok1, ok2 = false;
+    if (headless) {
+        const QString engine = parser.value("engine");
+        if (engine.isEmpty()) {
+            std::cerr << i18n("--dump and --watch require --engine").toLocal8Bit().data() << std::endl;
+            return 1;
+        }
+
+        const int interval = parser.value("interval").toInt(&ok1);
+        EngineDumper dumper(parser.isSet("watch") ? EngineDumper::Watch : EngineDumper::Dump);
+        QObject::connect(&dumper, &EngineDumper::finished, app.data(), [](int exitCode) {
+            QCoreApplication::exit(exitCode);
+        }, Qt::QueuedConnection);
+
+        if (!dumper.start(engine, parser.values("source"), ok1 ? interval : 0)) {
+            return 1;
+        }
+
+        return app->exec();
+    }
+
+    if (parser.isSet("stress-model")) {
+        StressModel *model = new StressModel;
+        model->setRate(parser.value("stress-model").toInt());
+        model->start();
+        ModelViewer *viewer = new ModelViewer(model);
+        viewer->show();
+        return app->exec();
+    }
+
     EngineExplorer* w = new EngineExplorer;
 
-    bool ok1, ok2 = false;
     //get size
     int x = parser.value("height").toInt(&ok1);
     int y = parser.value("width").toInt(&ok2);
@@ -123,15 +179,19 @@ int main(int argc, char **argv)
         w->setInterval(interval);
     }
 
-    //set engine
-    QString engine = parser.value("engine");
-    if (!engine.isEmpty()) {
-        w->setEngine(engine);
+    //set engine; any further engines are shown alongside the first one
+    QStringList engines = parser.values("engine");
+    if (!engines.isEmpty()) {
+        w->setEngine(engines.takeFirst());
 
         QString source = parser.value("source");
         if (!source.isEmpty()) {
             w->requestSource(source);
         }
+
+        foreach (const QString &engine, engines) {
+            w->attachEngine(engine);
+        }
     }
 
     if (parser.isSet("app")) {
@@ -139,5 +199,5 @@ int main(int argc, char **argv)
     }
 
     w->show();
-    return app.exec();
+    return app->exec();
 }
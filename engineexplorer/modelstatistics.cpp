@@ -0,0 +1,139 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "modelstatistics.h"
+
+#include <QAbstractItemModel>
+#include <QStringList>
+
+#include <KLocalizedString>
+
+ModelStatistics::ModelStatistics(QObject *parent)
+    : QObject(parent)
+{
+    m_sinceReset.start();
+}
+
+ModelStatistics::~ModelStatistics()
+{
+}
+
+void ModelStatistics::watchBefore(QAbstractItemModel *model)
+{
+    connect(model, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex &, int first, int last) {
+        begin(Inserts, last - first + 1);
+    });
+    connect(model, &QAbstractItemModel::rowsRemoved, this, [this](const QModelIndex &, int first, int last) {
+        begin(Removals, last - first + 1);
+    });
+    connect(model, &QAbstractItemModel::rowsMoved, this, [this](const QModelIndex &, int first, int last) {
+        begin(Moves, last - first + 1);
+    });
+    connect(model, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+        const qint64 rows = bottomRight.row() - topLeft.row() + 1;
+        const qint64 columns = bottomRight.column() - topLeft.column() + 1;
+        begin(DataChanges, rows * columns);
+    });
+    connect(model, &QAbstractItemModel::layoutChanged, this, [this]() {
+        begin(LayoutChanges, 0);
+    });
+    connect(model, &QAbstractItemModel::modelReset, this, [this]() {
+        begin(Resets, 0);
+    });
+}
+
+void ModelStatistics::watchAfter(QAbstractItemModel *model)
+{
+    connect(model, &QAbstractItemModel::rowsInserted, this, [this]() {
+        end(Inserts);
+    });
+    connect(model, &QAbstractItemModel::rowsRemoved, this, [this]() {
+        end(Removals);
+    });
+    connect(model, &QAbstractItemModel::rowsMoved, this, [this]() {
+        end(Moves);
+    });
+    connect(model, &QAbstractItemModel::dataChanged, this, [this]() {
+        end(DataChanges);
+    });
+    connect(model, &QAbstractItemModel::layoutChanged, this, [this]() {
+        end(LayoutChanges);
+    });
+    connect(model, &QAbstractItemModel::modelReset, this, [this]() {
+        end(Resets);
+    });
+}
+
+QString ModelStatistics::summary() const
+{
+    const QString names[KindCount] = {
+        i18nc("model signal statistics", "Inserted rows"),
+        i18nc("model signal statistics", "Removed rows"),
+        i18nc("model signal statistics", "Moved rows"),
+        i18nc("model signal statistics", "Changed data"),
+        i18nc("model signal statistics", "Layout changes"),
+        i18nc("model signal statistics", "Resets")
+    };
+
+    const double seconds = qMax<qint64>(1, m_sinceReset.elapsed()) / 1000.0;
+    QStringList lines;
+    for (int kind = 0; kind < KindCount; ++kind) {
+        const Counter &counter = m_counters[kind];
+        lines << i18nc("%1 is the kind of change, %2 the number of signals, %3 signals per second, %4 rows or cells, "
+                       "%5 and %6 the total and longest time the view spent processing them",
+                       "%1: %2 signals (%3/s), %4 items, view took %5 ms (max %6 ms)",
+                       names[kind], counter.signalCount,
+                       QString::number(counter.signalCount / seconds, 'f', 1),
+                       counter.items,
+                       QString::number(counter.nsecs / 1000000.0, 'f', 2),
+                       QString::number(counter.maxNsecs / 1000000.0, 'f', 2));
+    }
+
+    return lines.join(QLatin1Char('\n'));
+}
+
+void ModelStatistics::reset()
+{
+    for (int kind = 0; kind < KindCount; ++kind) {
+        m_counters[kind] = Counter();
+    }
+
+    m_sinceReset.restart();
+}
+
+void ModelStatistics::begin(Kind kind, qint64 items)
+{
+    ++m_counters[kind].signalCount;
+    m_counters[kind].items += items;
+    m_signalTimer.start();
+}
+
+void ModelStatistics::end(Kind kind)
+{
+    if (!m_signalTimer.isValid()) {
+        return;
+    }
+
+    const qint64 nsecs = m_signalTimer.nsecsElapsed();
+    m_signalTimer.invalidate();
+
+    Counter &counter = m_counters[kind];
+    counter.nsecs += nsecs;
+    counter.maxNsecs = qMax(counter.maxNsecs, nsecs);
+}
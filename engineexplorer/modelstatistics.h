@@ -0,0 +1,79 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MODELSTATISTICS_H
+#define MODELSTATISTICS_H
+
+#include <QElapsedTimer>
+#include <QObject>
+
+class QAbstractItemModel;
+
+/**
+ * Counts the change signals a model emits and measures how long the views
+ * attached to it take to process them.
+ *
+ * Slots connected to the same signal are called in the order they were
+ * connected, so watchBefore() has to be called before the model is set on the
+ * view and watchAfter() right after; the time between the two is what the
+ * view spent handling the change synchronously.
+ */
+class ModelStatistics : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Kind {
+        Inserts = 0,
+        Removals,
+        Moves,
+        DataChanges,
+        LayoutChanges,
+        Resets,
+        KindCount
+    };
+
+    explicit ModelStatistics(QObject *parent = nullptr);
+    ~ModelStatistics() override;
+
+    void watchBefore(QAbstractItemModel *model);
+    void watchAfter(QAbstractItemModel *model);
+
+    QString summary() const;
+
+public Q_SLOTS:
+    void reset();
+
+private:
+    struct Counter {
+        qint64 signalCount = 0;
+        qint64 items = 0;
+        qint64 nsecs = 0;
+        qint64 maxNsecs = 0;
+    };
+
+    void begin(Kind kind, qint64 items);
+    void end(Kind kind);
+
+    Counter m_counters[KindCount];
+    QElapsedTimer m_signalTimer;
+    QElapsedTimer m_sinceReset;
+};
+
+#endif // MODELSTATISTICS_H
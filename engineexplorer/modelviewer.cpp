@@ -20,8 +20,17 @@
 
 #include "modelviewer.h"
 
+#include <algorithm>
+
+#include <QComboBox>
 #include <QDebug>
 #include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QLabel>
+#include <QPainter>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
 #include <KMessageBox>
 #include <KStringHandler>
 #include <KLocalizedString>
@@ -31,6 +40,8 @@
 #include <Plasma/ServiceJob>
 
 #include "engineexplorer.h"
+#include "modelstatistics.h"
+#include "stressmodel.h"
 
 Delegate::Delegate(QObject *parent)
     : QAbstractItemDelegate(parent)
@@ -42,6 +53,52 @@ Delegate::~Delegate()
 {
 }
 
+const Delegate::RoleCache &Delegate::roleCache(const QAbstractItemModel *model, const QFont &font) const
+{
+    auto it = m_roleCaches.find(model);
+    if (it == m_roleCaches.end()) {
+        it = m_roleCaches.insert(model, RoleCache());
+        connect(model, &QAbstractItemModel::modelReset, this, [this, model]() {
+            m_roleCaches[model].valid = false;
+        });
+        connect(model, &QObject::destroyed, this, [this, model]() {
+            m_roleCaches.remove(model);
+        });
+    }
+
+    RoleCache &cache = *it;
+    if (cache.valid && cache.font == font) {
+        return cache;
+    }
+
+    const QHash<int, QByteArray> roleNames = model->roleNames();
+    QVector<int> roles;
+    roles.reserve(roleNames.count());
+    for (auto roleIt = roleNames.constBegin(); roleIt != roleNames.constEnd(); ++roleIt) {
+        roles << roleIt.key();
+    }
+    std::sort(roles.begin(), roles.end());
+
+    const QFontMetrics fm(font);
+    cache.roles = roles;
+    cache.labels.clear();
+    cache.labelWidths.clear();
+    cache.maxLabelWidth = 0;
+    foreach (int role, roles) {
+        const QString text = QString::fromUtf8(roleNames.value(role)) + QLatin1String(": ");
+        const int width = fm.width(text);
+        cache.labels << text;
+        cache.labelWidths << width;
+        cache.maxLabelWidth = qMax(cache.maxLabelWidth, width);
+    }
+    cache.lineHeight = fm.height();
+    cache.charWidth = fm.width(QLatin1Char('M'));
+    cache.font = font;
+    cache.valid = true;
+
+    return cache;
+}
+
 void Delegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
            const QModelIndex &index) const
 {
@@ -49,26 +106,21 @@ void Delegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
         return;
     }
 
-    QFontMetrics fm(option.font);
-    int maxWidth = 0;
-    foreach (int role, index.model()->roleNames().keys()) {
-        const QString text = index.model()->roleNames().value(role) + QLatin1String(": ");
-        maxWidth = qMax(maxWidth, fm.width(text));
-    }
+    const RoleCache &cache = roleCache(index.model(), option.font);
+    const int x = option.rect.x() + cache.maxLabelWidth;
 
-    int i = 2;
-    foreach (int role, index.model()->roleNames().keys()) {
-        const QString text = index.model()->roleNames().value(role) + QLatin1String(": ");
-        painter->drawText(option.rect.x() + maxWidth - fm.width(text), option.rect.y() + i*fm.height(), text);
+    for (int i = 0; i < cache.roles.count(); ++i) {
+        const int line = i + 2;
+        painter->drawText(x - cache.labelWidths.at(i), option.rect.y() + line * cache.lineHeight, cache.labels.at(i));
 
-        if (index.data(role).canConvert<QIcon>()) {
-            index.data(role).value<QIcon>().paint(painter, option.rect.x() + maxWidth, option.rect.y() + (i-1)*fm.height(), 16, 16);
-        } else if (!index.data(role).isValid()) {
-            painter->drawText(option.rect.x() + maxWidth, option.rect.y() + i*fm.height(), "null");
+        const QVariant value = index.data(cache.roles.at(i));
+        if (value.canConvert<QIcon>()) {
+            value.value<QIcon>().paint(painter, x, option.rect.y() + (line - 1) * cache.lineHeight, 16, 16);
+        } else if (!value.isValid()) {
+            painter->drawText(x, option.rect.y() + line * cache.lineHeight, QStringLiteral("null"));
         } else {
-            painter->drawText(option.rect.x() + maxWidth, option.rect.y() + i*fm.height(), index.data(role).toString());
+            painter->drawText(x, option.rect.y() + line * cache.lineHeight, value.toString());
         }
-        ++i;
     }
 }
 
@@ -80,22 +132,18 @@ QSize Delegate::sizeHint(const QStyleOptionViewItem &option,
         return QSize();
     }
 
-    QFontMetrics fm(option.font);
-    return QSize(fm.width("M") * 50, fm.height() * (index.model()->roleNames().count()+2));
+    const RoleCache &cache = roleCache(index.model(), option.font);
+    return QSize(cache.charWidth * 50, cache.lineHeight * (cache.roles.count() + 2));
 }
 
 
 ModelViewer::ModelViewer(Plasma::DataEngine *engine, const QString &source, QWidget *parent)
     : QDialog(parent),
       m_engine(engine),
-      m_source(source)
+      m_source(source),
+      m_model(nullptr)
 {
-    setAttribute(Qt::WA_DeleteOnClose);
-    m_view = new QTreeView(this);
-    m_view->setItemDelegate(new Delegate(m_view));
-    QVBoxLayout *layout = new QVBoxLayout();
-    layout->addWidget(m_view);
-    setLayout(layout);
+    init();
 
     QString engineName = i18nc("Plasma engine with unknown name", "Unknown");
 
@@ -104,11 +152,11 @@ ModelViewer::ModelViewer(Plasma::DataEngine *engine, const QString &source, QWid
             engineName = KStringHandler::capwords(m_engine->pluginInfo().name());
         }
         qDebug() << "########### CALLING SERVICE FOR SOURCE: " << m_source;
-        m_model = m_engine->modelForSource(m_source);
+        QAbstractItemModel *model = m_engine->modelForSource(m_source);
 
-        if (m_model != nullptr) {
+        if (model != nullptr) {
             connect(m_engine, SIGNAL(destroyed(QObject*)), this, SLOT(engineDestroyed()));
-            m_view->setModel(m_model);
+            setModel(model);
         } else {
             KMessageBox::sorry(this, i18n("No valid model was returned. Verify that a model is available for this source."));
             close();
@@ -118,11 +166,110 @@ ModelViewer::ModelViewer(Plasma::DataEngine *engine, const QString &source, QWid
     setWindowTitle(i18nc("%1 is a Plasma dataengine name", "%1 Model Explorer", engineName));
 }
 
+ModelViewer::ModelViewer(StressModel *model, QWidget *parent)
+    : QDialog(parent),
+      m_engine(nullptr),
+      m_model(nullptr)
+{
+    init();
+
+    model->setParent(this);
+    setModel(model);
+
+    QSpinBox *rate = new QSpinBox(this);
+    rate->setRange(0, 1000000);
+    rate->setValue(model->rate());
+    rate->setSuffix(i18nc("changes per second", " /s"));
+    connect(rate, SIGNAL(valueChanged(int)), model, SLOT(setRate(int)));
+
+    QComboBox *change = new QComboBox(this);
+    change->addItem(i18nc("kind of model change", "Data changes"), StressModel::DataChange);
+    change->addItem(i18nc("kind of model change", "Row insertions"), StressModel::Insert);
+    change->addItem(i18nc("kind of model change", "Row removals"), StressModel::Remove);
+    change->addItem(i18nc("kind of model change", "Row moves"), StressModel::Move);
+    change->addItem(i18nc("kind of model change", "Model resets"), StressModel::Reset);
+    change->addItem(i18nc("kind of model change", "Mixed"), StressModel::Mixed);
+    change->setCurrentIndex(change->findData(model->change()));
+    connect(change, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), model, [model, change](int index) {
+        model->setChange(change->itemData(index).toInt());
+    });
+
+    QSpinBox *rows = new QSpinBox(this);
+    rows->setRange(0, 10000000);
+    rows->setValue(model->initialRowCount());
+    connect(rows, SIGNAL(valueChanged(int)), model, SLOT(setInitialRowCount(int)));
+
+    QPushButton *running = new QPushButton(i18n("Run"), this);
+    running->setCheckable(true);
+    running->setChecked(model->isRunning());
+    connect(running, &QPushButton::toggled, model, [model](bool run) {
+        if (run) {
+            model->start();
+        } else {
+            model->stop();
+        }
+    });
+
+    QFormLayout *controls = new QFormLayout();
+    controls->addRow(i18n("Changes per second:"), rate);
+    controls->addRow(i18n("Kind of change:"), change);
+    controls->addRow(i18n("Rows:"), rows);
+    controls->addRow(QString(), running);
+    static_cast<QVBoxLayout *>(layout())->insertLayout(0, controls);
+
+    setWindowTitle(i18n("Model Stress Test"));
+}
+
 ModelViewer::~ModelViewer()
 {
     m_engine = nullptr;
 }
 
+void ModelViewer::init()
+{
+    setAttribute(Qt::WA_DeleteOnClose);
+    m_view = new QTreeView(this);
+    m_view->setItemDelegate(new Delegate(m_view));
+
+    m_statistics = new ModelStatistics(this);
+    m_statisticsLabel = new QLabel(this);
+    m_statisticsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    QPushButton *resetStatistics = new QPushButton(i18n("Reset Statistics"), this);
+    connect(resetStatistics, SIGNAL(clicked()), m_statistics, SLOT(reset()));
+    connect(resetStatistics, SIGNAL(clicked()), this, SLOT(updateStatistics()));
+
+    QTimer *statisticsTimer = new QTimer(this);
+    statisticsTimer->setInterval(1000);
+    connect(statisticsTimer, SIGNAL(timeout()), this, SLOT(updateStatistics()));
+    statisticsTimer->start();
+
+    QHBoxLayout *statisticsLayout = new QHBoxLayout();
+    statisticsLayout->addWidget(m_statisticsLabel, 1);
+    statisticsLayout->addWidget(resetStatistics, 0, Qt::AlignTop);
+
+    QVBoxLayout *layout = new QVBoxLayout();
+    layout->addWidget(m_view);
+    layout->addLayout(statisticsLayout);
+    setLayout(layout);
+
+    updateStatistics();
+}
+
+void ModelViewer::setModel(QAbstractItemModel *model)
+{
+    m_model = model;
+
+    // the view connects to the model in setModel(), so this brackets
+    // its own handling of every change signal
+    m_statistics->watchBefore(model);
+    m_view->setModel(model);
+    m_statistics->watchAfter(model);
+}
+
+void ModelViewer::updateStatistics()
+{
+    m_statisticsLabel->setText(m_statistics->summary());
+}
 
 void ModelViewer::engineDestroyed()
 {
@@ -131,5 +278,3 @@ void ModelViewer::engineDestroyed()
     hide();
     deleteLater();
 }
-
-
@@ -23,10 +23,16 @@
 
 #include <QDialog>
 #include <QAbstractItemDelegate>
+#include <QFont>
+#include <QHash>
 #include <QStyleOptionViewItem>
+#include <QVector>
 
 class QAbstractItemModel;
+class QLabel;
 class QTreeView;
+class ModelStatistics;
+class StressModel;
 
 namespace Plasma
 {
@@ -47,6 +53,26 @@ public:
 protected:
     QSize sizeHint(const QStyleOptionViewItem &option,
                    const QModelIndex &index) const override;
+
+private:
+    /**
+     * What paint() and sizeHint() need to know about the roles of a model;
+     * computed once per model and font, and again after the model was reset
+     */
+    struct RoleCache {
+        QVector<int> roles;
+        QVector<QString> labels;
+        QVector<int> labelWidths;
+        int maxLabelWidth = 0;
+        int lineHeight = 0;
+        int charWidth = 0;
+        QFont font;
+        bool valid = false;
+    };
+
+    const RoleCache &roleCache(const QAbstractItemModel *model, const QFont &font) const;
+
+    mutable QHash<const QAbstractItemModel *, RoleCache> m_roleCaches;
 };
 
 class ModelViewer : public QDialog
@@ -55,17 +81,28 @@ class ModelViewer : public QDialog
 
 public:
     ModelViewer(Plasma::DataEngine *engine, const QString &m_source, QWidget *parent = nullptr);
+
+    /**
+     * Shows @p model together with the controls to drive it; the viewer
+     * takes ownership of the model.
+     */
+    explicit ModelViewer(StressModel *model, QWidget *parent = nullptr);
     ~ModelViewer() override;
 
 private Q_SLOTS:
     void engineDestroyed();
+    void updateStatistics();
 
 private:
+    void init();
+    void setModel(QAbstractItemModel *model);
+
     Plasma::DataEngine *m_engine;
     QString m_source;
     QAbstractItemModel *m_model;
     QTreeView *m_view;
+    ModelStatistics *m_statistics;
+    QLabel *m_statisticsLabel;
 };
 
 #endif
-
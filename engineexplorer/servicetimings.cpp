@@ -0,0 +1,138 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "servicetimings.h"
+
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+static qint64 nearestRank(const QVector<qint64> &sorted, int percent)
+{
+    const int rank = qMax(1, (percent * sorted.count() + 99) / 100);
+    return sorted.at(qMin(rank, sorted.count()) - 1);
+}
+
+static QJsonObject traceEvent(const QString &name, const QString &category, qint64 start, qint64 end, int lane)
+{
+    QJsonObject event;
+    event.insert(QStringLiteral("name"), name);
+    event.insert(QStringLiteral("cat"), category);
+    event.insert(QStringLiteral("ph"), QStringLiteral("X"));
+    // the trace format counts in microseconds
+    event.insert(QStringLiteral("ts"), start / 1000.0);
+    event.insert(QStringLiteral("dur"), (end - start) / 1000.0);
+    event.insert(QStringLiteral("pid"), QCoreApplication::applicationPid());
+    event.insert(QStringLiteral("tid"), lane);
+    return event;
+}
+
+ServiceTimings::ServiceTimings()
+{
+    m_clock.start();
+}
+
+qint64 ServiceTimings::now() const
+{
+    return m_clock.nsecsElapsed();
+}
+
+ServiceTimings::Sample ServiceTimings::begin(const QString &operation)
+{
+    Sample sample;
+    sample.operation = operation;
+
+    // every running job gets a lane of its own, so the spans in the trace
+    // never overlap on one row
+    sample.lane = m_lanes.indexOf(false);
+    if (sample.lane == -1) {
+        sample.lane = m_lanes.count();
+        m_lanes << true;
+    } else {
+        m_lanes[sample.lane] = true;
+    }
+
+    sample.start = now();
+    return sample;
+}
+
+void ServiceTimings::finish(Sample &sample, const QString &destination, bool failed)
+{
+    sample.end = now();
+    sample.destination = destination;
+    sample.failed = failed;
+
+    if (sample.lane >= 0 && sample.lane < m_lanes.count()) {
+        m_lanes[sample.lane] = false;
+    }
+
+    QVector<qint64> &durations = m_durations[sample.operation];
+    const qint64 duration = sample.end - sample.start;
+    durations.insert(std::upper_bound(durations.begin(), durations.end(), duration), duration);
+    m_samples << sample;
+}
+
+QStringList ServiceTimings::operations() const
+{
+    return m_durations.keys();
+}
+
+ServiceTimings::Percentiles ServiceTimings::percentiles(const QString &operation) const
+{
+    Percentiles result;
+    const QVector<qint64> sorted = m_durations.value(operation);
+    if (sorted.isEmpty()) {
+        return result;
+    }
+
+    result.count = sorted.count();
+    result.p50 = nearestRank(sorted, 50);
+    result.p95 = nearestRank(sorted, 95);
+    result.p99 = nearestRank(sorted, 99);
+    result.max = sorted.last();
+    return result;
+}
+
+bool ServiceTimings::exportTrace(QIODevice *device) const
+{
+    QJsonArray events;
+    foreach (const Sample &sample, m_samples) {
+        QJsonObject job = traceEvent(sample.operation, QStringLiteral("service"), sample.start, sample.end, sample.lane);
+        QJsonObject args;
+        args.insert(QStringLiteral("destination"), sample.destination);
+        args.insert(QStringLiteral("failed"), sample.failed);
+        job.insert(QStringLiteral("args"), args);
+        events << job;
+
+        if (sample.dispatched >= sample.start && sample.dispatched <= sample.end) {
+            events << traceEvent(QStringLiteral("queued"), QStringLiteral("service"), sample.start, sample.dispatched, sample.lane);
+        }
+    }
+
+    QJsonObject trace;
+    trace.insert(QStringLiteral("traceEvents"), events);
+    trace.insert(QStringLiteral("displayTimeUnit"), QStringLiteral("ms"));
+
+    const QByteArray json = QJsonDocument(trace).toJson(QJsonDocument::Compact);
+    return device->write(json) == json.size();
+}
@@ -0,0 +1,90 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SERVICETIMINGS_H
+#define SERVICETIMINGS_H
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QIODevice;
+
+/**
+ * Collects the timings of service jobs: per operation latency percentiles,
+ * and a trace of every job which can be exported in the Chrome trace event
+ * format (chrome://tracing, Perfetto).
+ *
+ * A job is timed from the call to startOperationCall() until its result is
+ * handled. Where known, the moment the event loop first got back to us after
+ * starting it is recorded too, which shows how long jobs sat in the queue.
+ */
+class ServiceTimings
+{
+public:
+    struct Sample {
+        QString operation;
+        QString destination;
+        qint64 start = -1;
+        qint64 dispatched = -1;
+        qint64 end = -1;
+        int lane = -1;
+        bool failed = false;
+    };
+
+    struct Percentiles {
+        int count = 0;
+        qint64 p50 = 0;
+        qint64 p95 = 0;
+        qint64 p99 = 0;
+        qint64 max = 0;
+    };
+
+    ServiceTimings();
+
+    /**
+     * @return the current time in nanoseconds, on the clock all samples use
+     */
+    qint64 now() const;
+
+    /**
+     * Starts timing a job running @p operation.
+     */
+    Sample begin(const QString &operation);
+
+    /**
+     * Stops timing @p sample and adds it to the statistics.
+     */
+    void finish(Sample &sample, const QString &destination, bool failed);
+
+    QStringList operations() const;
+    Percentiles percentiles(const QString &operation) const;
+
+    bool exportTrace(QIODevice *device) const;
+
+private:
+    QElapsedTimer m_clock;
+    QVector<bool> m_lanes;
+    QVector<Sample> m_samples;
+    QMap<QString, QVector<qint64> > m_durations;
+};
+
+#endif // SERVICETIMINGS_H
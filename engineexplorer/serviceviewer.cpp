@@ -21,6 +21,13 @@
 
 #include <QDebug>
 #include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
 #include <KMessageBox>
 #include <KStringHandler>
 #include <KLocalizedString>
@@ -37,7 +44,12 @@ ServiceViewer::ServiceViewer(Plasma::DataEngine *engine, const QString &source,
       m_service(nullptr),
       m_source(source),
       m_operationCount(0),
-      m_operationButton(new QPushButton(i18n("Start Operation"), this))
+      m_operationButton(new QPushButton(i18n("Start Operation"), this)),
+      m_batchButton(new QPushButton(i18n("Run Batch..."), this)),
+      m_traceButton(new QPushButton(i18n("Export Trace..."), this)),
+      m_batchRunning(0),
+      m_batchDone(0),
+      m_batchFailed(0)
 {
     setAttribute(Qt::WA_DeleteOnClose);
     QWidget* mainWidget = new QWidget(this);
@@ -45,6 +57,8 @@ ServiceViewer::ServiceViewer(Plasma::DataEngine *engine, const QString &source,
 
     QDialogButtonBox *buttonBox = new QDialogButtonBox(this);
     buttonBox->addButton(m_operationButton, QDialogButtonBox::ActionRole);
+    buttonBox->addButton(m_batchButton, QDialogButtonBox::ActionRole);
+    buttonBox->addButton(m_traceButton, QDialogButtonBox::ActionRole);
     buttonBox->addButton(QDialogButtonBox::Close);
 
     connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject()));
@@ -58,6 +72,12 @@ ServiceViewer::ServiceViewer(Plasma::DataEngine *engine, const QString &source,
 
     connect(m_operationButton, SIGNAL(clicked()), this, SLOT(startOperation()));
     m_operationButton->setEnabled(false);
+    connect(m_batchButton, SIGNAL(clicked()), this, SLOT(startBatch()));
+    m_batchButton->setEnabled(false);
+    connect(m_traceButton, SIGNAL(clicked()), this, SLOT(exportTrace()));
+    m_traceButton->setEnabled(false);
+    m_results->horizontalHeader()->setStretchLastSection(true);
+    m_latencies->setSortingEnabled(true);
 
     connect(m_operations, SIGNAL(currentIndexChanged(QString)),
             this, SLOT(operationSelected(QString)));
@@ -122,6 +142,7 @@ void ServiceViewer::updateOperations()
     m_operations->setEnabled(enable);
     m_operationsLabel->setEnabled(enable);
     m_operationDescription->setEnabled(enable);
+    m_batchButton->setEnabled(enable);
 }
 
 void ServiceViewer::startOperation()
@@ -145,9 +166,170 @@ void ServiceViewer::startOperation()
         desc[key] = value;
     }
 
+    startJob(operation, desc, false);
+}
+
+void ServiceViewer::startBatch()
+{
+    if (!m_service) {
+        return;
+    }
+
+    const QString fileName = QFileDialog::getOpenFileName(this, i18n("Open Batch File"), QString(),
+                                                          i18n("JSON files (*.json)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        KMessageBox::sorry(this, i18n("Could not open <b>%1</b>.", fileName));
+        return;
+    }
+
+    // a list of {"operation": name, "parameters": {key: value}, "repeat": count}
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isArray()) {
+        KMessageBox::sorry(this, i18n("<b>%1</b> is not a valid batch file: %2", fileName,
+                                      error.error != QJsonParseError::NoError ? error.errorString()
+                                                                               : i18n("expected a list of operations")));
+        return;
+    }
+
+    const QStringList operations = m_service->operationNames();
+    foreach (const QJsonValue &value, doc.array()) {
+        const QJsonObject entry = value.toObject();
+        QueuedOperation queued;
+        queued.operation = entry.value(QStringLiteral("operation")).toString();
+        if (!operations.contains(queued.operation)) {
+            addResult(queued.operation, QString(), i18n("Unknown operation"), -1, QString());
+            continue;
+        }
+
+        queued.parameters = m_service->operationDescription(queued.operation);
+        const QVariantMap parameters = entry.value(QStringLiteral("parameters")).toObject().toVariantMap();
+        for (auto it = parameters.constBegin(); it != parameters.constEnd(); ++it) {
+            queued.parameters[it.key()] = it.value();
+        }
+
+        const int repeat = qMax(1, entry.value(QStringLiteral("repeat")).toInt(1));
+        for (int i = 0; i < repeat; ++i) {
+            m_queue << queued;
+        }
+    }
+
+    if (m_batchRunning == 0) {
+        m_batchDone = 0;
+        m_batchFailed = 0;
+        m_batchTimer.start();
+    }
+
+    startQueuedJobs();
+}
+
+void ServiceViewer::startJob(const QString &operation, const QVariantMap &parameters, bool batch)
+{
     updateJobCount(1);
-    Plasma::ServiceJob *job = m_service->startOperationCall(desc);
+
+    RunningJob running;
+    running.sample = m_timings.begin(operation);
+    running.batch = batch;
+    Plasma::ServiceJob *job = m_service->startOperationCall(parameters);
+    m_jobs.insert(job, running);
     connect(job, SIGNAL(finished(KJob*)), this, SLOT(operationResult(KJob*)));
+
+    // the job starts itself from the event loop; this runs right after it got
+    // there, so the gap is the time spent waiting behind other events
+    QTimer::singleShot(0, this, [this, job]() {
+        auto it = m_jobs.find(job);
+        if (it != m_jobs.end() && it->sample.dispatched < 0) {
+            it->sample.dispatched = m_timings.now();
+        }
+    });
+}
+
+void ServiceViewer::startQueuedJobs()
+{
+    while (m_service && !m_queue.isEmpty() && m_batchRunning < m_concurrency->value()) {
+        const QueuedOperation queued = m_queue.takeFirst();
+        ++m_batchRunning;
+        startJob(queued.operation, queued.parameters, true);
+    }
+
+    if (m_batchRunning > 0 || !m_queue.isEmpty()) {
+        m_operationStatus->setText(i18np("Batch: one operation finished, %2 queued", "Batch: %1 operations finished, %2 queued",
+                                         m_batchDone, m_queue.count()));
+        m_operationStatus->show();
+    } else if (m_batchDone > 0) {
+        m_operationStatus->setText(i18np("Batch finished: one operation in %2 ms, %3 failed",
+                                         "Batch finished: %1 operations in %2 ms, %3 failed",
+                                         m_batchDone, m_batchTimer.elapsed(), m_batchFailed));
+        m_operationStatus->show();
+    }
+}
+
+void ServiceViewer::addResult(const QString &operation, const QString &destination, const QString &status,
+                              qint64 nsecs, const QString &result)
+{
+    const int row = m_results->rowCount();
+    m_results->insertRow(row);
+    m_results->setItem(row, 0, new QTableWidgetItem(operation));
+    m_results->setItem(row, 1, new QTableWidgetItem(destination));
+    m_results->setItem(row, 2, new QTableWidgetItem(status));
+
+    QTableWidgetItem *latency = new QTableWidgetItem();
+    if (nsecs >= 0) {
+        latency->setData(Qt::DisplayRole, nsecs / 1000000.0);
+    }
+    m_results->setItem(row, 3, latency);
+
+    QTableWidgetItem *resultItem = new QTableWidgetItem(result);
+    resultItem->setToolTip(result);
+    m_results->setItem(row, 4, resultItem);
+    m_results->scrollToBottom();
+}
+
+void ServiceViewer::updateLatencies()
+{
+    m_latencies->setSortingEnabled(false);
+    const QStringList operations = m_timings.operations();
+    m_latencies->setRowCount(operations.count());
+
+    int row = 0;
+    foreach (const QString &operation, operations) {
+        const ServiceTimings::Percentiles percentiles = m_timings.percentiles(operation);
+        const qint64 values[] = { percentiles.p50, percentiles.p95, percentiles.p99, percentiles.max };
+
+        m_latencies->setItem(row, 0, new QTableWidgetItem(operation));
+        QTableWidgetItem *count = new QTableWidgetItem();
+        count->setData(Qt::DisplayRole, percentiles.count);
+        m_latencies->setItem(row, 1, count);
+        for (int i = 0; i < 4; ++i) {
+            QTableWidgetItem *item = new QTableWidgetItem();
+            item->setData(Qt::DisplayRole, values[i] / 1000000.0);
+            m_latencies->setItem(row, i + 2, item);
+        }
+
+        ++row;
+    }
+
+    m_latencies->setSortingEnabled(true);
+    m_traceButton->setEnabled(!operations.isEmpty());
+}
+
+void ServiceViewer::exportTrace()
+{
+    const QString fileName = QFileDialog::getSaveFileName(this, i18n("Export Trace"), QString(),
+                                                          i18n("Trace files (*.json)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || !m_timings.exportTrace(&file)) {
+        KMessageBox::sorry(this, i18n("Could not write the trace to <b>%1</b>.", fileName));
+    }
 }
 
 void ServiceViewer::operationSelected(const QString &operation)
@@ -179,34 +361,47 @@ void ServiceViewer::operationSelected(const QString &operation)
 
 void ServiceViewer::operationResult(KJob *j)
 {
-    if (!m_service) {
-        return;
+    const bool known = m_jobs.contains(j);
+    RunningJob running = m_jobs.take(j);
+    Plasma::ServiceJob *job = qobject_cast<Plasma::ServiceJob *>(j);
+
+    // finished before anything else, or the lane of the job would stay busy
+    qint64 nsecs = -1;
+    if (known) {
+        m_timings.finish(running.sample, job ? job->destination() : QString(), j->error());
+        nsecs = running.sample.end - running.sample.start;
     }
 
-    Plasma::ServiceJob *job = qobject_cast<Plasma::ServiceJob *>(j);
-    if (!job) {
+    if (!m_service || !job) {
         return;
     }
 
+    if (known) {
+        updateLatencies();
+    }
+
     updateJobCount(-1);
 
     if (job->error()) {
-        KMessageBox::information(this,
-                                 i18n("<b>'%1'</b> operation with destination <b>'%2'</b> failed. "
-                                      "<p>The error was: <b>'%3: %4'</b></p>", job->operationName(), job->destination(),
-                                      job->error(), job->errorString()),
-                                 i18n("Operation Result"));
+        addResult(job->operationName(), job->destination(),
+                  i18n("Failed"), nsecs,
+                  i18nc("%1 is an error code, %2 the error message", "%1: %2", job->error(), job->errorString()));
     } else {
         QString result = EngineExplorer::convertToString(job->result());
         if (result.isEmpty()) {
             result = i18n("No response from job.");
         }
 
-        KMessageBox::information(this,
-                                 i18n("<b>'%1'</b> operation with destination <b>'%2'</b> returned successfully. "
-                                      "<p>The result was: <b>'%3'</b></p>", job->operationName(),
-                                      job->destination(), result),
-                                 i18n("Operation Result"));
+        addResult(job->operationName(), job->destination(), i18n("Succeeded"), nsecs, result);
+    }
+
+    if (running.batch) {
+        --m_batchRunning;
+        ++m_batchDone;
+        if (job->error()) {
+            ++m_batchFailed;
+        }
+        startQueuedJobs();
     }
 
     qDebug() << "operation results are in!";
@@ -21,6 +21,12 @@
 #define SERVICEVIEWER_H
 
 #include <QDialog>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QVariantMap>
+
+#include "servicetimings.h"
 #include "ui_serviceviewer.h"
 
 class KJob;
@@ -41,11 +47,28 @@ public:
     ~ServiceViewer() override;
 
 private:
+    struct QueuedOperation {
+        QString operation;
+        QVariantMap parameters;
+    };
+
+    struct RunningJob {
+        ServiceTimings::Sample sample;
+        bool batch = false;
+    };
+
     void updateJobCount(int numberOfJobs);
+    void startJob(const QString &operation, const QVariantMap &parameters, bool batch);
+    void startQueuedJobs();
+    void addResult(const QString &operation, const QString &destination, const QString &status,
+                   qint64 nsecs, const QString &result);
+    void updateLatencies();
 
 private Q_SLOTS:
     void updateOperations();
     void startOperation();
+    void startBatch();
+    void exportTrace();
     void operationSelected(const QString &operation);
     void operationResult(KJob *job);
     void engineDestroyed();
@@ -56,6 +79,15 @@ private:
     QString m_source;
     int m_operationCount;
     QPushButton *m_operationButton;
+    QPushButton *m_batchButton;
+    QPushButton *m_traceButton;
+    QList<QueuedOperation> m_queue;
+    QHash<KJob *, RunningJob> m_jobs;
+    int m_batchRunning;
+    int m_batchDone;
+    int m_batchFailed;
+    QElapsedTimer m_batchTimer;
+    ServiceTimings m_timings;
 };
 
 #endif
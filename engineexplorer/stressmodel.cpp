@@ -0,0 +1,216 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "stressmodel.h"
+
+// the timer granularity; the changes due in between are applied in one go
+static const int s_tickInterval = 16;
+
+StressModel::StressModel(QObject *parent)
+    : QAbstractListModel(parent),
+      m_initialRowCount(0),
+      m_rate(100),
+      m_change(DataChange),
+      m_generation(0),
+      m_budget(0)
+{
+    m_timer.setInterval(s_tickInterval);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+    setInitialRowCount(1000);
+}
+
+StressModel::~StressModel()
+{
+}
+
+QHash<int, QByteArray> StressModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles.insert(Qt::DisplayRole, "display");
+    roles.insert(ValueRole, "value");
+    roles.insert(GenerationRole, "generation");
+    return roles;
+}
+
+int StressModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return m_rows.count();
+}
+
+QVariant StressModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.count()) {
+        return QVariant();
+    }
+
+    const Row &row = m_rows.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return QString(QLatin1String("Row ") + QString::number(index.row()));
+    case ValueRole:
+        return row.value;
+    case GenerationRole:
+        return row.generation;
+    default:
+        return QVariant();
+    }
+}
+
+int StressModel::rate() const
+{
+    return m_rate;
+}
+
+StressModel::Change StressModel::change() const
+{
+    return m_change;
+}
+
+int StressModel::initialRowCount() const
+{
+    return m_initialRowCount;
+}
+
+bool StressModel::isRunning() const
+{
+    return m_timer.isActive();
+}
+
+void StressModel::setRate(int changesPerSecond)
+{
+    m_rate = qMax(0, changesPerSecond);
+}
+
+void StressModel::setChange(int change)
+{
+    m_change = static_cast<Change>(qBound(int(DataChange), change, int(Mixed)));
+}
+
+void StressModel::setInitialRowCount(int rows)
+{
+    beginResetModel();
+    m_initialRowCount = qMax(0, rows);
+    m_rows.clear();
+    m_rows.reserve(m_initialRowCount);
+    for (int i = 0; i < m_initialRowCount; ++i) {
+        m_rows << newRow();
+    }
+    endResetModel();
+}
+
+void StressModel::start()
+{
+    m_budget = 0;
+    m_clock.start();
+    m_timer.start();
+}
+
+void StressModel::stop()
+{
+    m_timer.stop();
+}
+
+void StressModel::tick()
+{
+    const qint64 elapsed = m_clock.restart();
+
+    // don't try to catch up if a tick got delayed by a slow view, that would
+    // only make the next one slower
+    m_budget = qMin(m_budget + m_rate * elapsed / 1000.0, qMax(1.0, double(m_rate)));
+
+    while (m_budget >= 1) {
+        m_budget -= 1;
+        apply(m_change == Mixed ? static_cast<Change>(m_random() % Mixed) : m_change);
+    }
+}
+
+StressModel::Row StressModel::newRow()
+{
+    Row row;
+    row.value = int(m_random() % 1000);
+    row.generation = ++m_generation;
+    return row;
+}
+
+int StressModel::randomRow()
+{
+    return int(m_random() % quint32(m_rows.count()));
+}
+
+void StressModel::apply(Change change)
+{
+    // keep the row count around the initial one, whatever the kind of change
+    if (change == Insert && m_rows.count() >= qMax(1, m_initialRowCount * 2)) {
+        change = Remove;
+    } else if (change != Insert && change != Reset && m_rows.isEmpty()) {
+        change = Insert;
+    } else if (change == Move && m_rows.count() < 2) {
+        change = Insert;
+    }
+
+    switch (change) {
+    case DataChange: {
+        const int row = randomRow();
+        m_rows[row] = newRow();
+        const QModelIndex idx = index(row, 0);
+        emit dataChanged(idx, idx);
+        break;
+    }
+    case Insert: {
+        const int row = m_rows.isEmpty() ? 0 : int(m_random() % quint32(m_rows.count() + 1));
+        beginInsertRows(QModelIndex(), row, row);
+        m_rows.insert(row, newRow());
+        endInsertRows();
+        break;
+    }
+    case Remove: {
+        const int row = randomRow();
+        beginRemoveRows(QModelIndex(), row, row);
+        m_rows.remove(row);
+        endRemoveRows();
+        break;
+    }
+    case Move: {
+        const int from = randomRow();
+        int to = randomRow();
+        // beginMoveRows() refuses moves onto the row itself or right below it
+        if (to == from || to == from + 1) {
+            to = from == 0 ? m_rows.count() : 0;
+        }
+        beginMoveRows(QModelIndex(), from, from, QModelIndex(), to);
+        const Row row = m_rows.takeAt(from);
+        m_rows.insert(to > from ? to - 1 : to, row);
+        endMoveRows();
+        break;
+    }
+    case Reset:
+        beginResetModel();
+        for (int i = 0; i < m_rows.count(); ++i) {
+            m_rows[i] = newRow();
+        }
+        endResetModel();
+        break;
+    case Mixed:
+        break;
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef STRESSMODEL_H
+#define STRESSMODEL_H
+
+#include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+
+#include <random>
+
+/**
+ * A synthetic model which changes itself at a configurable rate, to measure
+ * what a given kind and frequency of model changes costs a view.
+ */
+class StressModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Change {
+        DataChange = 0,
+        Insert,
+        Remove,
+        Move,
+        Reset,
+        Mixed
+    };
+
+    enum Roles {
+        ValueRole = Qt::UserRole + 1,
+        GenerationRole
+    };
+
+    explicit StressModel(QObject *parent = nullptr);
+    ~StressModel() override;
+
+    QHash<int, QByteArray> roleNames() const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    int rate() const;
+    Change change() const;
+    int initialRowCount() const;
+    bool isRunning() const;
+
+public Q_SLOTS:
+    void setRate(int changesPerSecond);
+    void setChange(int change);
+    void setInitialRowCount(int rows);
+    void start();
+    void stop();
+
+private Q_SLOTS:
+    void tick();
+
+private:
+    struct Row {
+        int value;
+        quint64 generation;
+    };
+
+    Row newRow();
+    int randomRow();
+    void apply(Change change);
+
+    QVector<Row> m_rows;
+    int m_initialRowCount;
+    int m_rate;
+    Change m_change;
+    quint64 m_generation;
+    double m_budget;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    std::minstd_rand m_random;
+};
+
+#endif // STRESSMODEL_H
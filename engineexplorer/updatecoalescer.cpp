@@ -0,0 +1,100 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "updatecoalescer.h"
+
+// how long updates are collected before they are handed on
+static const int s_flushInterval = 50;
+
+SourceReceiver::SourceReceiver(const QString &engine, UpdateCoalescer *coalescer)
+    : QObject(coalescer),
+      m_engine(engine),
+      m_coalescer(coalescer)
+{
+}
+
+void SourceReceiver::dataUpdated(const QString &source, const Plasma::DataEngine::Data &data)
+{
+    m_coalescer->queue(m_engine, source, data);
+}
+
+UpdateCoalescer::UpdateCoalescer(QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(s_flushInterval);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(flush()));
+}
+
+UpdateCoalescer::~UpdateCoalescer()
+{
+}
+
+QObject *UpdateCoalescer::receiverFor(const QString &engine)
+{
+    SourceReceiver *receiver = m_receivers.value(engine);
+    if (!receiver) {
+        receiver = new SourceReceiver(engine, this);
+        m_receivers.insert(engine, receiver);
+    }
+
+    return receiver;
+}
+
+void UpdateCoalescer::removeReceiver(const QString &engine)
+{
+    // deleting the receiver also disconnects it from all the sources
+    delete m_receivers.take(engine);
+    drop(engine);
+}
+
+void UpdateCoalescer::queue(const QString &engine, const QString &source, const Plasma::DataEngine::Data &data)
+{
+    m_pending[engine].insert(source, data);
+
+    if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void UpdateCoalescer::drop(const QString &engine, const QString &source)
+{
+    if (source.isEmpty()) {
+        m_pending.remove(engine);
+        return;
+    }
+
+    auto it = m_pending.find(engine);
+    if (it != m_pending.end()) {
+        it->remove(source);
+    }
+}
+
+void UpdateCoalescer::flush()
+{
+    // slots may queue or drop updates while we deliver, so work on a copy
+    QHash<QString, QHash<QString, Plasma::DataEngine::Data> > pending;
+    pending.swap(m_pending);
+
+    for (auto engineIt = pending.constBegin(); engineIt != pending.constEnd(); ++engineIt) {
+        for (auto sourceIt = engineIt->constBegin(); sourceIt != engineIt->constEnd(); ++sourceIt) {
+            emit dataReady(engineIt.key(), sourceIt.key(), sourceIt.value());
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef UPDATECOALESCER_H
+#define UPDATECOALESCER_H
+
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+
+#include <Plasma/DataEngine>
+
+class UpdateCoalescer;
+
+/**
+ * The object sources of one engine are connected to; forwards every update
+ * to the coalescer tagged with the name of the engine.
+ */
+class SourceReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    SourceReceiver(const QString &engine, UpdateCoalescer *coalescer);
+
+public Q_SLOTS:
+    void dataUpdated(const QString &source, const Plasma::DataEngine::Data &data);
+
+private:
+    QString m_engine;
+    UpdateCoalescer *m_coalescer;
+};
+
+/**
+ * Collects the updates of the sources of any number of engines and hands them
+ * on in batches, keeping only the latest data of every source. Engines
+ * updating faster than the view can follow then cost one model update per
+ * source and interval instead of one per update.
+ */
+class UpdateCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UpdateCoalescer(QObject *parent = nullptr);
+    ~UpdateCoalescer() override;
+
+    /**
+     * @return the object to connect the sources of @p engine to
+     */
+    QObject *receiverFor(const QString &engine);
+    void removeReceiver(const QString &engine);
+
+    void queue(const QString &engine, const QString &source, const Plasma::DataEngine::Data &data);
+    void drop(const QString &engine, const QString &source = QString());
+
+Q_SIGNALS:
+    void dataReady(const QString &engine, const QString &source, const Plasma::DataEngine::Data &data);
+
+private Q_SLOTS:
+    void flush();
+
+private:
+    QTimer m_timer;
+    QHash<QString, SourceReceiver *> m_receivers;
+    QHash<QString, QHash<QString, Plasma::DataEngine::Data> > m_pending;
+};
+
+#endif // UPDATECOALESCER_H
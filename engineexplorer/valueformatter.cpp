@@ -0,0 +1,394 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "valueformatter.h"
+
+#include <QBitArray>
+#include <QBitmap>
+#include <QDateTime>
+#include <QHash>
+#include <QImage>
+#include <QLine>
+#include <QLocale>
+#include <QPixmap>
+#include <QRegExp>
+#include <QRegion>
+#include <QStringList>
+#include <QUrl>
+
+#include <KLocalizedString>
+
+#include <Plasma/DataEngine>
+
+#ifdef FOUND_SOPRANO
+#include <Soprano/Node>
+Q_DECLARE_METATYPE(Soprano::Node)
+#endif // FOUND_SOPRANO
+
+namespace
+{
+
+QString pixelFormat(int width, int height, int depth)
+{
+    return QLatin1Char('<') % QString::number(width) % QLatin1Char('x') % QString::number(height)
+           % QLatin1String("px - ") % QString::number(depth) % QLatin1String("bpp>");
+}
+
+template<typename T>
+QString lineFormat(const T &line)
+{
+    return QLatin1String("<x1:") % QString::number(line.x1()) % QLatin1String(", y1:") % QString::number(line.y1())
+           % QLatin1String(", x2:") % QString::number(line.x2()) % QLatin1String(", y2:") % QString::number(line.y2())
+           % QLatin1Char('>');
+}
+
+template<typename T>
+QString pointFormat(const T &point)
+{
+    return QLatin1String("<x:") % QString::number(point.x()) % QLatin1String(", y:") % QString::number(point.y())
+           % QLatin1Char('>');
+}
+
+template<typename T>
+QString rectFormat(const T &rect)
+{
+    return QLatin1String("<x:") % QString::number(rect.x()) % QLatin1String(", y:") % QString::number(rect.y())
+           % QLatin1String(", w:") % QString::number(rect.width()) % QLatin1String(", h:") % QString::number(rect.height())
+           % QLatin1Char('>');
+}
+
+template<typename T>
+QString sizeFormat(const T &size)
+{
+    return QLatin1String("<w:") % QString::number(size.width()) % QLatin1String(", h:") % QString::number(size.height())
+           % QLatin1Char('>');
+}
+
+QString formatLines(const QVariantMap &map)
+{
+    QString str;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        if (!str.isEmpty()) {
+            str += QLatin1Char('\n');
+        }
+        str += it.key() % QLatin1String(": ") % ValueFormatter::format(it.value());
+    }
+
+    return str;
+}
+
+QString formatBitArray(const QVariant &value)
+{
+    return i18np("<1 bit>", "<%1 bits>", value.toBitArray().size());
+}
+
+QString formatBitmap(const QVariant &value)
+{
+    const QBitmap bitmap = value.value<QBitmap>();
+    return pixelFormat(bitmap.width(), bitmap.height(), bitmap.depth());
+}
+
+QString formatByteArray(const QVariant &value)
+{
+    // Return the array size if it is not displayable
+    const QString str = value.toString();
+    if (str.isEmpty()) {
+        return i18np("<1 byte>", "<%1 bytes>", value.toByteArray().size());
+    }
+
+    return str;
+}
+
+QString formatImage(const QVariant &value)
+{
+    const QImage image = value.value<QImage>();
+    return pixelFormat(image.width(), image.height(), image.depth());
+}
+
+QString formatLine(const QVariant &value)
+{
+    return lineFormat(value.toLine());
+}
+
+QString formatLineF(const QVariant &value)
+{
+    return lineFormat(value.toLineF());
+}
+
+QString formatLocale(const QVariant &value)
+{
+    return value.toLocale().name();
+}
+
+QString formatMap(const QVariant &value)
+{
+    const QVariantMap map = value.toMap();
+    const QString str = i18np("<1 item>", "<%1 items>", map.size());
+
+    if (map.isEmpty()) {
+        return str;
+    }
+
+    return str % QLatin1Char('\n') % formatLines(map);
+}
+
+QString formatHash(const QVariant &value)
+{
+    return formatLines(value.value<Plasma::DataEngine::Data>());
+}
+
+QString formatPixmap(const QVariant &value)
+{
+    const QPixmap pixmap = value.value<QPixmap>();
+    return pixelFormat(pixmap.width(), pixmap.height(), pixmap.depth());
+}
+
+QString formatPoint(const QVariant &value)
+{
+    return pointFormat(value.toPoint());
+}
+
+QString formatPointF(const QVariant &value)
+{
+    return pointFormat(value.toPointF());
+}
+
+QString formatRect(const QVariant &value)
+{
+    return rectFormat(value.toRect());
+}
+
+QString formatRectF(const QVariant &value)
+{
+    return rectFormat(value.toRectF());
+}
+
+QString formatRegExp(const QVariant &value)
+{
+    return value.toRegExp().pattern();
+}
+
+QString formatRegion(const QVariant &value)
+{
+    return rectFormat(value.value<QRegion>().boundingRect());
+}
+
+QString formatSize(const QVariant &value)
+{
+    return sizeFormat(value.toSize());
+}
+
+QString formatSizeF(const QVariant &value)
+{
+    return sizeFormat(value.toSizeF());
+}
+
+QString formatUrl(const QVariant &value)
+{
+    return value.toUrl().toString();
+}
+
+QString formatStringList(const QVariant &value)
+{
+    return value.toStringList().join(QLatin1String(", "));
+}
+
+QString formatDate(const QVariant &value)
+{
+    return value.toDate().toString();
+}
+
+QString formatDateTime(const QVariant &value)
+{
+    return value.toDateTime().toString();
+}
+
+QString formatTime(const QVariant &value)
+{
+    return value.toTime().toString();
+}
+
+QString formatString(const QVariant &value)
+{
+    const QString str = value.toString();
+    if (str.isEmpty()) {
+        return i18nc("The user did a query to a dataengine and it returned empty data", "<empty>");
+    }
+
+    return str;
+}
+
+#ifdef FOUND_SOPRANO
+QString formatSopranoNode(const QVariant &value)
+{
+    const Soprano::Node node = value.value<Soprano::Node>();
+    if (node.isLiteral()) {
+        return ValueFormatter::format(node.literal().variant());
+    } else if (node.isResource()) {
+        return node.uri().toString();
+    } else if (node.isBlank()) {
+        return QLatin1String("_:") % node.identifier();
+    }
+
+    return QString();
+}
+#endif
+
+QString formatFallback(const QVariant &value)
+{
+    if (value.canConvert<QVariantMap>()) {
+        const Plasma::DataEngine::Data data = value.value<Plasma::DataEngine::Data>();
+        if (!data.isEmpty()) {
+            return formatLines(data);
+        }
+    }
+
+    if (value.canConvert(QVariant::String)) {
+        return formatString(value);
+    }
+
+    return i18nc("A the dataengine returned something that the humble view on the engineexplorer can't display, like a picture", "<not displayable>");
+}
+
+class FormatterTable
+{
+public:
+    FormatterTable()
+    {
+        formatters.insert(QMetaType::QBitArray, formatBitArray);
+        formatters.insert(QMetaType::QBitmap, formatBitmap);
+        formatters.insert(QMetaType::QByteArray, formatByteArray);
+        formatters.insert(QMetaType::QImage, formatImage);
+        formatters.insert(QMetaType::QLine, formatLine);
+        formatters.insert(QMetaType::QLineF, formatLineF);
+        formatters.insert(QMetaType::QLocale, formatLocale);
+        formatters.insert(QMetaType::QVariantMap, formatMap);
+        formatters.insert(QMetaType::QVariantHash, formatHash);
+        formatters.insert(QMetaType::QPixmap, formatPixmap);
+        formatters.insert(QMetaType::QPoint, formatPoint);
+        formatters.insert(QMetaType::QPointF, formatPointF);
+        formatters.insert(QMetaType::QRect, formatRect);
+        formatters.insert(QMetaType::QRectF, formatRectF);
+        formatters.insert(QMetaType::QRegExp, formatRegExp);
+        formatters.insert(QMetaType::QRegion, formatRegion);
+        formatters.insert(QMetaType::QSize, formatSize);
+        formatters.insert(QMetaType::QSizeF, formatSizeF);
+        formatters.insert(QMetaType::QUrl, formatUrl);
+        formatters.insert(QMetaType::QStringList, formatStringList);
+        formatters.insert(QMetaType::QDate, formatDate);
+        formatters.insert(QMetaType::QDateTime, formatDateTime);
+        formatters.insert(QMetaType::QTime, formatTime);
+
+        // the common scalar types, which would otherwise end up probing
+        // the fallback conversions
+        formatters.insert(QMetaType::QString, formatString);
+        formatters.insert(QMetaType::QChar, formatString);
+        formatters.insert(QMetaType::Bool, formatString);
+        formatters.insert(QMetaType::Int, formatString);
+        formatters.insert(QMetaType::UInt, formatString);
+        formatters.insert(QMetaType::LongLong, formatString);
+        formatters.insert(QMetaType::ULongLong, formatString);
+        formatters.insert(QMetaType::Double, formatString);
+        formatters.insert(QMetaType::Float, formatString);
+
+#ifdef FOUND_SOPRANO
+        formatters.insert(qRegisterMetaType<Soprano::Node>(), formatSopranoNode);
+#endif
+    }
+
+    QHash<int, ValueFormatter::Formatter> formatters;
+};
+
+Q_GLOBAL_STATIC(FormatterTable, s_formatterTable)
+
+} // namespace
+
+ValueFormatter::ValueFormatter(int maxCachedSlots)
+    : m_cache(maxCachedSlots)
+{
+}
+
+ValueFormatter::~ValueFormatter()
+{
+}
+
+QString ValueFormatter::format(const QVariant &value)
+{
+    const Formatter formatter = s_formatterTable->formatters.value(value.userType(), formatFallback);
+    return formatter(value);
+}
+
+bool ValueFormatter::isContainer(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::QVariantList:
+    case QMetaType::QStringList:
+    case QMetaType::QVariantMap:
+    case QMetaType::QVariantHash:
+        return true;
+    case QMetaType::QString:
+    case QMetaType::QByteArray:
+        return false;
+    default:
+        return value.canConvert(QVariant::List) || value.canConvert(QVariant::Map);
+    }
+}
+
+QString ValueFormatter::summarize(const QVariant &value)
+{
+    if (!isContainer(value)) {
+        return format(value);
+    }
+
+    const int size = value.canConvert(QVariant::List) ? value.toList().size() : value.toMap().size();
+    return i18np("<1 item>", "<%1 items>", size);
+}
+
+QString ValueFormatter::cachedFormat(const QString &slot, const QVariant &value, bool *changed)
+{
+    return cached(slot, value, changed, format);
+}
+
+QString ValueFormatter::cachedSummary(const QString &slot, const QVariant &value, bool *changed)
+{
+    return cached(slot, value, changed, summarize);
+}
+
+QString ValueFormatter::cached(const QString &slot, const QVariant &value, bool *changed, Formatter formatter)
+{
+    Entry *entry = m_cache.object(slot);
+
+    // implicitly shared values which were not touched by the engine compare
+    // by their shared data pointer, which makes this check cheap
+    if (entry && entry->formatter == formatter &&
+        entry->value.userType() == value.userType() && entry->value == value) {
+        if (changed) {
+            *changed = false;
+        }
+        return entry->text;
+    }
+
+    if (changed) {
+        *changed = true;
+    }
+
+    const QString text = formatter(value);
+    m_cache.insert(slot, new Entry{value, text, formatter});
+    return text;
+}
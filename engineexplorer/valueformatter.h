@@ -0,0 +1,84 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as
+ *   published by the Free Software Foundation; either version 2,
+ *   or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef VALUEFORMATTER_H
+#define VALUEFORMATTER_H
+
+#include <QCache>
+#include <QString>
+#include <QVariant>
+
+/**
+ * Turns the values published by data engines into display text.
+ *
+ * Formatting is dispatched through a table of formatters keyed by metatype id
+ * which is built once per process. On top of that every instance keeps a
+ * cache of the last value seen for a given slot (usually engine, source and
+ * key) together with its text, so values which did not change between two
+ * updates are not formatted again.
+ */
+class ValueFormatter
+{
+public:
+    typedef QString (*Formatter)(const QVariant &value);
+
+    explicit ValueFormatter(int maxCachedSlots = 8192);
+    ~ValueFormatter();
+
+    /**
+     * Formats @p value without going through the cache.
+     */
+    static QString format(const QVariant &value);
+
+    /**
+     * Returns true for lists and maps, whose elements can be shown as
+     * children instead of being flattened into a single string.
+     */
+    static bool isContainer(const QVariant &value);
+
+    /**
+     * Like format(), except that containers are only described by their size.
+     */
+    static QString summarize(const QVariant &value);
+
+    /**
+     * Formats @p value, reusing the text computed for @p slot if the value
+     * stored there is still the same. @p changed, if given, is set to whether
+     * the value differs from the one seen last time for this slot.
+     */
+    QString cachedFormat(const QString &slot, const QVariant &value, bool *changed = nullptr);
+
+    /**
+     * Cached variant of summarize(), see cachedFormat().
+     */
+    QString cachedSummary(const QString &slot, const QVariant &value, bool *changed = nullptr);
+
+private:
+    QString cached(const QString &slot, const QVariant &value, bool *changed, Formatter formatter);
+
+    struct Entry {
+        QVariant value;
+        QString text;
+        Formatter formatter;
+    };
+
+    QCache<QString, Entry> m_cache;
+};
+
+#endif // VALUEFORMATTER_H
@@ -211,6 +211,18 @@ Kirigami.AbstractApplicationWindow {
                     }
                 }
             }
+            ProgressBar {
+                anchors {
+                    left: parent.left
+                    right: parent.right
+                    bottom: parent.bottom
+                    margins: units.smallSpacing
+                }
+                visible: lnfLogic.processingThumbnail
+                minimumValue: 0
+                maximumValue: 100
+                value: lnfLogic.thumbnailProgress
+            }
         }
     }
     Button {
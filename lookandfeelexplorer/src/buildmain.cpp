@@ -0,0 +1,115 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QStandardPaths>
+
+#include <klocalizedstring.h>
+#include <qcommandlineparser.h>
+#include <qcommandlineoption.h>
+
+#include "lnfbuilder.h"
+
+int main(int argc, char **argv)
+{
+    // neither a display nor a session bus is needed
+    QCoreApplication app(argc, argv);
+
+    app.setApplicationVersion(PROJECT_VERSION);
+
+    QCommandLineParser parser;
+    parser.addVersionOption();
+    parser.addHelpOption();
+    parser.setApplicationDescription(i18n("Builds a Plasma Look And Feel package without a running Plasma session"));
+
+    QCommandLineOption pluginNameOption(QStringList() << "p" << "plugin-name", i18n("The plugin name of the package, also the name of its directory"), "name");
+    QCommandLineOption nameOption(QStringList() << "name", i18n("The name shown for the package"), "name");
+    QCommandLineOption commentOption(QStringList() << "comment", i18n("The description of the package"), "comment");
+    QCommandLineOption authorOption(QStringList() << "author", i18n("The author of the package"), "author");
+    QCommandLineOption emailOption(QStringList() << "email", i18n("The email address of the author"), "email");
+    QCommandLineOption licenseOption(QStringList() << "license", i18n("The license of the package"), "license", "LGPL 2.1+");
+    QCommandLineOption websiteOption(QStringList() << "website", i18n("The website of the package"), "url");
+    QCommandLineOption versionOption(QStringList() << "package-version", i18n("The version of the package"), "version", "0.1");
+    QCommandLineOption layoutOption(QStringList() << "layout", i18n("The desktop layout script to ship"), "file");
+    QCommandLineOption screenshotOption(QStringList() << "screenshot", i18n("The image to make the previews from"), "file");
+    QCommandLineOption configOption(QStringList() << "config", i18n("Capture the defaults of a config file from another file, e.g. kwinrc=/path/to/kwinrc; can be given more than once"), "name=path");
+    QCommandLineOption noDefaultsOption(QStringList() << "no-defaults", i18n("Do not capture any defaults"));
+    QCommandLineOption outputOption(QStringList() << "o" << "output", i18n("The directory to put the package into, instead of the look and feel packages of the user"), "directory");
+
+    parser.addOption(pluginNameOption);
+    parser.addOption(nameOption);
+    parser.addOption(commentOption);
+    parser.addOption(authorOption);
+    parser.addOption(emailOption);
+    parser.addOption(licenseOption);
+    parser.addOption(websiteOption);
+    parser.addOption(versionOption);
+    parser.addOption(layoutOption);
+    parser.addOption(screenshotOption);
+    parser.addOption(configOption);
+    parser.addOption(noDefaultsOption);
+    parser.addOption(outputOption);
+
+    parser.process(app);
+
+    LnfBuilder::Parameters parameters;
+    parameters.metadata.pluginName = parser.value(pluginNameOption);
+    if (parameters.metadata.pluginName.isEmpty()) {
+        std::cerr << i18n("No plugin name given, use --plugin-name").toLocal8Bit().constData() << std::endl;
+        return 1;
+    }
+    parameters.metadata.name = parser.isSet(nameOption) ? parser.value(nameOption) : parameters.metadata.pluginName;
+    parameters.metadata.comment = parser.value(commentOption);
+    parameters.metadata.author = parser.value(authorOption);
+    parameters.metadata.email = parser.value(emailOption);
+    parameters.metadata.license = parser.value(licenseOption);
+    parameters.metadata.website = parser.value(websiteOption);
+    parameters.metadata.version = parser.value(versionOption);
+
+    parameters.layoutFile = parser.value(layoutOption);
+    parameters.screenshot = parser.value(screenshotOption);
+    parameters.captureDefaults = !parser.isSet(noDefaultsOption);
+
+    foreach (const QString &config, parser.values(configOption)) {
+        const int separator = config.indexOf(QLatin1Char('='));
+        if (separator <= 0) {
+            std::cerr << i18n("Invalid config source \"%1\", expected name=path", config).toLocal8Bit().constData() << std::endl;
+            return 1;
+        }
+        parameters.configSources.insert(config.left(separator), config.mid(separator + 1));
+    }
+
+    parameters.outputDir = parser.value(outputOption);
+    if (parameters.outputDir.isEmpty()) {
+        parameters.outputDir = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) % QLatin1String("/plasma/look-and-feel");
+    }
+
+    const LnfBuilder::Result result = LnfBuilder::build(parameters);
+    if (!result.success) {
+        foreach (const QString &error, result.errors) {
+            std::cerr << error.toLocal8Bit().constData() << std::endl;
+        }
+        return 2;
+    }
+
+    std::cout << result.packagePath.toLocal8Bit().constData() << std::endl;
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "lnfbuilder.h"
+#include "lnfdefaults.h"
+#include "thumbnailwriter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QtConcurrentRun>
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KLocalizedString>
+
+// the steps return an error message, or nothing if they succeeded
+
+static QString writePackage(const QString &root, const LnfBuilder::Parameters &parameters)
+{
+    if (!LnfBuilder::writeMetadata(root % QLatin1String("/metadata.desktop"), parameters.metadata)) {
+        return i18n("Impossible to write the metadata of the look and feel package");
+    }
+
+    if (parameters.layoutFile.isEmpty()) {
+        return QString();
+    }
+
+    if (!QDir(root).mkpath(QStringLiteral("contents/layouts"))) {
+        return i18n("Impossible to create the layouts directory in the look and feel package");
+    }
+    if (!QFile::copy(parameters.layoutFile, root % QLatin1String("/contents/layouts/org.kde.plasma.desktop-layout.js"))) {
+        return i18n("Impossible to copy the layout script %1", parameters.layoutFile);
+    }
+
+    return QString();
+}
+
+static QString writePreviews(const QString &root, const LnfBuilder::Parameters &parameters)
+{
+    return ThumbnailWriter::write(parameters.screenshot, root % QLatin1String("/contents/previews")).error;
+}
+
+static QString writeDefaults(const QString &root, const LnfBuilder::Parameters &parameters)
+{
+    if (!QDir(root).mkpath(QStringLiteral("contents"))) {
+        return i18n("Impossible to create the contents directory in the look and feel package");
+    }
+
+    const QVector<LnfDefaults::Entry> entries = LnfDefaults::entries();
+    if (!LnfDefaults::write(root % QLatin1String("/contents/defaults"), entries, LnfDefaults::capture(entries, parameters.configSources))) {
+        return i18n("Impossible to write the defaults config file");
+    }
+
+    return QString();
+}
+
+bool LnfBuilder::writeMetadata(const QString &path, const Metadata &metadata)
+{
+    KConfig c(path, KConfig::SimpleConfig);
+
+    KConfigGroup cg(&c, "Desktop Entry");
+    cg.writeEntry("Name", metadata.name);
+    cg.writeEntry("Comment", metadata.comment);
+    cg.writeEntry("X-KDE-PluginInfo-Name", metadata.pluginName);
+    cg.writeEntry("X-KDE-ServiceTypes", "Plasma/LookAndFeel");
+    cg.writeEntry("X-KDE-PluginInfo-Author", metadata.author);
+    cg.writeEntry("X-KDE-PluginInfo-Email", metadata.email);
+    cg.writeEntry("X-KDE-PluginInfo-Website", metadata.website);
+    cg.writeEntry("X-KDE-PluginInfo-Category", "Plasma Look And Feel");
+    cg.writeEntry("X-KDE-PluginInfo-License", metadata.license);
+    cg.writeEntry("X-KDE-PluginInfo-EnabledByDefault", "true");
+    cg.writeEntry("X-KDE-PluginInfo-Version", metadata.version);
+    return c.sync();
+}
+
+LnfBuilder::Result LnfBuilder::build(const Parameters &parameters)
+{
+    Result result;
+
+    const QString pluginName = parameters.metadata.pluginName;
+    if (pluginName.isEmpty() || pluginName.contains(QLatin1Char('/')) || pluginName.startsWith(QLatin1Char('.'))) {
+        result.errors << i18n("Invalid plugin name \"%1\"", pluginName);
+        return result;
+    }
+
+    if (!QDir().mkpath(parameters.outputDir)) {
+        result.errors << i18n("Impossible to create the directory %1", parameters.outputDir);
+        return result;
+    }
+
+    // inside the output directory, so it is writable and on the same file
+    // system for the rename, but a level deeper than the packages the
+    // explorers list, which would show a half built one otherwise
+    const QString stagingDir = parameters.outputDir % QLatin1String("/.lookandfeelexplorer-build");
+    if (!QDir().mkpath(stagingDir)) {
+        result.errors << i18n("Impossible to create the directory %1", stagingDir);
+        return result;
+    }
+    QTemporaryDir staging(stagingDir % QLatin1Char('/') % pluginName % QLatin1String("-XXXXXX"));
+    if (!staging.isValid()) {
+        result.errors << i18n("Impossible to create a temporary directory in %1", stagingDir);
+        return result;
+    }
+    const QString root = staging.path();
+
+    QList<QFuture<QString> > steps;
+    steps << QtConcurrent::run(&writePackage, root, parameters);
+    if (!parameters.screenshot.isEmpty()) {
+        steps << QtConcurrent::run(&writePreviews, root, parameters);
+    }
+    if (parameters.captureDefaults) {
+        steps << QtConcurrent::run(&writeDefaults, root, parameters);
+    }
+
+    foreach (QFuture<QString> step, steps) {
+        const QString error = step.result();
+        if (!error.isEmpty()) {
+            result.errors << error;
+        }
+    }
+    if (!result.errors.isEmpty()) {
+        return result;
+    }
+
+    // QTemporaryDir makes it private to the user
+    QFile::setPermissions(root, QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner
+                                | QFile::ReadGroup | QFile::ExeGroup | QFile::ReadOther | QFile::ExeOther);
+
+    const QString destination = parameters.outputDir % QLatin1Char('/') % pluginName;
+    QString previous;
+    if (QFileInfo::exists(destination)) {
+        previous = root % QLatin1String(".old");
+        if (!QDir().rename(destination, previous)) {
+            result.errors << i18n("Impossible to replace %1", destination);
+            return result;
+        }
+    }
+
+    if (!QDir().rename(root, destination)) {
+        if (!previous.isEmpty()) {
+            QDir().rename(previous, destination);
+        }
+        result.errors << i18n("Impossible to replace %1", destination);
+        return result;
+    }
+    staging.setAutoRemove(false);
+
+    if (!previous.isEmpty()) {
+        QDir(previous).removeRecursively();
+    }
+    // only goes away if no other build is running
+    QDir().rmdir(stagingDir);
+
+    result.success = true;
+    result.packagePath = destination;
+    return result;
+}
@@ -0,0 +1,80 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LNFBUILDER_H
+#define LNFBUILDER_H
+
+#include <QHash>
+#include <QStringList>
+
+/**
+ * Builds a look and feel package from files alone, without a running
+ * Plasma session: the layout comes from a script instead of plasmashell
+ * and the defaults from given config files instead of the user's ones.
+ */
+class LnfBuilder
+{
+public:
+    struct Metadata {
+        QString pluginName;
+        QString name;
+        QString comment;
+        QString author;
+        QString email;
+        QString license;
+        QString website;
+        QString version = QStringLiteral("0.1");
+    };
+
+    struct Parameters {
+        Metadata metadata;
+        // the desktop layout script; none is shipped if empty
+        QString layoutFile;
+        // the screenshot for the previews; none are made if empty
+        QString screenshot;
+        // config files to capture the defaults from, by name, e.g. "kwinrc"
+        QHash<QString, QString> configSources;
+        bool captureDefaults = true;
+        // the directory the package goes into, as a subdirectory
+        QString outputDir;
+    };
+
+    struct Result {
+        bool success = false;
+        QString packagePath;
+        QStringList errors;
+    };
+
+    /**
+     * Writes the metadata.desktop of a look and feel package to @p path.
+     */
+    static bool writeMetadata(const QString &path, const Metadata &metadata);
+
+    /**
+     * Builds the package in a hidden directory below the output directory,
+     * with the layout, the previews and the defaults written in parallel.
+     *
+     * Only a complete package is moved to the destination. A package already
+     * there is moved aside first, so for a moment between the two renames
+     * there is none at the destination.
+     */
+    static Result build(const Parameters &parameters);
+};
+
+#endif // LNFBUILDER_H
@@ -0,0 +1,89 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "lnfdefaults.h"
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KSharedConfig>
+
+QVector<LnfDefaults::Entry> LnfDefaults::entries()
+{
+    static const QVector<Entry> entries = {
+        //widget style
+        {QStringLiteral("kdeglobals"), QStringLiteral("KDE"), QStringLiteral("widgetStyle"),
+         QStringLiteral("KDE"), QStringLiteral("widgetStyle"), QStringLiteral("breeze")},
+        //color scheme (TODO: create an in-place color scheme?)
+        {QStringLiteral("kdeglobals"), QStringLiteral("General"), QStringLiteral("ColorScheme"),
+         QStringLiteral("General"), QStringLiteral("ColorScheme"), QStringLiteral("Breeze")},
+        //plasma theme
+        {QStringLiteral("plasmarc"), QStringLiteral("Theme"), QStringLiteral("name"),
+         QStringLiteral("Theme"), QStringLiteral("name"), QStringLiteral("default")},
+        //cursor theme
+        {QStringLiteral("kcminputrc"), QStringLiteral("Mouse"), QStringLiteral("cursorTheme"),
+         QStringLiteral("Mouse"), QStringLiteral("cursorTheme"), QStringLiteral("breeze_cursors")},
+        //KWin window switcher theme
+        {QStringLiteral("kwinrc"), QStringLiteral("TabBox"), QStringLiteral("LayoutName"),
+         QStringLiteral("WindowSwitcher"), QStringLiteral("LayoutName"), QStringLiteral("org.kde.breeze.desktop")},
+        {QStringLiteral("kwinrc"), QStringLiteral("TabBox"), QStringLiteral("DesktopLayout"),
+         QStringLiteral("DesktopSwitcher"), QStringLiteral("LayoutName"), QStringLiteral("org.kde.breeze.desktop")},
+        //window decoration
+        {QStringLiteral("kwinrc"), QStringLiteral("org.kde.kdecoration2"), QStringLiteral("library"),
+         QStringLiteral("org.kde.kdecoration2"), QStringLiteral("library"), QStringLiteral("org.kde.breeze")},
+        {QStringLiteral("kwinrc"), QStringLiteral("org.kde.kdecoration2"), QStringLiteral("theme"),
+         QStringLiteral("org.kde.kdecoration2"), QStringLiteral("theme"), QString()}
+    };
+
+    return entries;
+}
+
+QStringList LnfDefaults::capture(const QVector<Entry> &entries, const QHash<QString, QString> &sources)
+{
+    QHash<QString, KSharedConfigPtr> configs;
+    QStringList values;
+    values.reserve(entries.count());
+
+    foreach (const Entry &entry, entries) {
+        auto it = configs.constFind(entry.file);
+        if (it == configs.constEnd()) {
+            // a file given as a source stands on its own, without the
+            // system wide files cascading into it
+            const QString source = sources.value(entry.file);
+            it = configs.insert(entry.file, source.isEmpty() ? KSharedConfig::openConfig(entry.file)
+                                                             : KSharedConfig::openConfig(source, KConfig::SimpleConfig));
+        }
+
+        values << KConfigGroup(*it, entry.group).readEntry(entry.key, entry.fallback);
+    }
+
+    return values;
+}
+
+bool LnfDefaults::write(const QString &path, const QVector<Entry> &entries, const QStringList &values)
+{
+    KConfig defaults(path, KConfig::SimpleConfig);
+
+    for (int i = 0; i < entries.count() && i < values.count(); ++i) {
+        const Entry &entry = entries.at(i);
+        KConfigGroup fileGroup(&defaults, entry.file);
+        KConfigGroup(&fileGroup, entry.defaultsGroup).writeEntry(entry.defaultsKey, values.at(i));
+    }
+
+    return defaults.sync();
+}
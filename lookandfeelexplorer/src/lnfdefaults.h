@@ -0,0 +1,72 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LNFDEFAULTS_H
+#define LNFDEFAULTS_H
+
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * The settings a look and feel package takes over from a setup, and how
+ * they end up in the contents/defaults file of the package.
+ *
+ * In the defaults file every setting lives below a group named after the
+ * config file it is applied to, e.g. [kdeglobals][KDE] widgetStyle.
+ */
+class LnfDefaults
+{
+public:
+    struct Entry {
+        // where the setting is read from
+        QString file;
+        QString group;
+        QString key;
+        // where it goes below the [file] group of the defaults
+        QString defaultsGroup;
+        QString defaultsKey;
+        // what is written when the setup does not have the setting
+        QString fallback;
+    };
+
+    /**
+     * @return the settings captured by default; capturing one more is a
+     * matter of adding it here
+     */
+    static QVector<Entry> entries();
+
+    /**
+     * Reads the value of each of @p entries, parsing every config file
+     * only once.
+     *
+     * @param sources paths to read a config file from, by its name, e.g.
+     * "kwinrc"; the files of the current user are read for the others
+     * @return the values, in the order of @p entries
+     */
+    static QStringList capture(const QVector<Entry> &entries, const QHash<QString, QString> &sources = QHash<QString, QString>());
+
+    /**
+     * Writes @p values for @p entries to the defaults file at @p path,
+     * with a single sync.
+     */
+    static bool write(const QString &path, const QVector<Entry> &entries, const QStringList &values);
+};
+
+#endif // LNFDEFAULTS_H
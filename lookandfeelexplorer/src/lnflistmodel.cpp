@@ -28,21 +28,22 @@
 
 #include "lnflistmodel.h"
 
+#include "packagecatalogue.h"
+
 #include <QApplication>
 #include <QDir>
 #include <QFile>
 #include <QPainter>
 #include <QStandardPaths>
 
-#include <KDesktopFile>
-
 #include <Plasma/Theme>
 #include <qstandardpaths.h>
 
 #include <QDebug>
 
 LnfListModel::LnfListModel( QObject *parent )
-: QAbstractListModel( parent )
+: QAbstractListModel( parent ),
+  m_catalogue(new PackageCatalogue(QStringLiteral("plasma/look-and-feel"), this))
 {
     m_roleNames.insert(Qt::DisplayRole, "displayRole");
     m_roleNames.insert(PackageNameRole, "packageNameRole");
@@ -50,6 +51,7 @@ LnfListModel::LnfListModel( QObject *parent )
     m_roleNames.insert(PackageAuthorRole, "packageAuthorRole");
     m_roleNames.insert(PackageVersionRole, "packageVersionRole");
 
+    connect(m_catalogue, SIGNAL(packagesChanged()), this, SLOT(updateThemes()));
     reload();
 }
 
@@ -69,52 +71,24 @@ void LnfListModel::clearThemeList()
 }
 
 void LnfListModel::reload()
+{
+    // only reads the metadata of the packages which changed since the last time
+    m_catalogue->scan();
+}
+
+void LnfListModel::updateThemes()
 {
     beginResetModel();
     clearThemeList();
 
-    // get all desktop themes
-    QStringList themes;
-    const QStringList &packs = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, "plasma/look-and-feel", QStandardPaths::LocateDirectory);
-    foreach (const QString &ppath, packs) {
-        const QDir cd(ppath);
-        const QStringList &entries = cd.entryList(QDir::Dirs | QDir::Hidden);
-        foreach (const QString pack, entries) {
-            const QString _metadata = ppath+QLatin1Char('/')+pack+QStringLiteral("/metadata.desktop");
-            if ((pack != "." && pack != "..") &&
-                (QFile::exists(_metadata))) {
-                themes << _metadata;
-            }
-        }
-    }
-
-    foreach (const QString &theme, themes) {
-        int themeSepIndex = theme.lastIndexOf('/', -1);
-        QString themeRoot = theme.left(themeSepIndex);
-        int themeNameSepIndex = themeRoot.lastIndexOf('/', -1);
-        QString packageName = themeRoot.right(themeRoot.length() - themeNameSepIndex - 1);
-
-        KDesktopFile df(theme);
-
-        if (df.noDisplay()) {
-            continue;
-        }
-
-        QString name = df.readName();
-        if (name.isEmpty()) {
-            name = packageName;
-        }
-        const QString comment = df.readComment();
-        const QString author = df.desktopGroup().readEntry("X-KDE-PluginInfo-Author",QString());
-        const QString version = df.desktopGroup().readEntry("X-KDE-PluginInfo-Version",QString());
-
+    foreach (const PackageCatalogue::Package &package, m_catalogue->packages()) {
         ThemeInfo info;
-        info.name = name;
-        info.package = packageName;
-        info.description = comment;
-        info.author = author;
-        info.version = version;
-        info.themeRoot = themeRoot;
+        info.name = package.name;
+        info.package = package.pluginName;
+        info.description = package.comment;
+        info.author = package.author;
+        info.version = package.version;
+        info.themeRoot = package.root;
         m_themes << info;
     }
 
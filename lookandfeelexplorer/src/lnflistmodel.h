@@ -36,6 +36,8 @@ namespace Plasma
     class FrameSvg;
 }
 
+class PackageCatalogue;
+
 //Theme selector code by Andre Duffeck (modified to add package description)
 class ThemeInfo
 {
@@ -79,8 +81,12 @@ public:
 Q_SIGNALS:
     void countChanged();
 
+private Q_SLOTS:
+    void updateThemes();
+
 private:
     QHash<int, QByteArray> m_roleNames;
+    PackageCatalogue *m_catalogue;
 
     QList<ThemeInfo> m_themes;
 };
@@ -19,6 +19,8 @@
 
 #include "lnflogic.h"
 #include "lnflistmodel.h"
+#include "lnfbuilder.h"
+#include "lnfdefaults.h"
 
 #include <QDir>
 #include <QFile>
@@ -26,6 +28,7 @@
 #include <QDebug>
 #include <QStandardPaths>
 #include <QUrl>
+#include <QtConcurrentRun>
 
 #include <QDBusMessage>
 #include <QDBusConnection>
@@ -36,40 +39,42 @@
 #include <KConfigGroup>
 #include <KPackage/PackageLoader>
 #include <KAboutData>
-#include <KSharedConfig>
 #include <KLocalizedString>
 
 LnfLogic::LnfLogic(QObject *parent)
     : QObject(parent),
       m_themeName(QStringLiteral("org.kde.breeze.desktop")),
       m_lnfListModel(new LnfListModel(this)),
-      m_needsSave(false)
+      m_needsSave(false),
+      m_thumbnailProgress(0)
 {
     m_package = KPackage::PackageLoader::self()->loadPackage(QStringLiteral("Plasma/LookAndFeel"));
+
+    connect(&m_thumbnail, SIGNAL(finished()), this, SLOT(thumbnailFinished()));
 }
 
 LnfLogic::~LnfLogic()
 {
+    m_thumbnail.waitForFinished();
 }
 
 void LnfLogic::createNewTheme(const QString &pluginName, const QString &name, const QString &comment, const QString &author, const QString &email, const QString &license, const QString &website)
 {
     const QString metadataPath(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) % QLatin1Literal("/plasma/look-and-feel/") % pluginName % QLatin1Literal("/metadata.desktop"));
-    KConfig c(metadataPath);
 
-    KConfigGroup cg(&c, "Desktop Entry");
-    cg.writeEntry("Name", name);
-    cg.writeEntry("Comment", comment);
-    cg.writeEntry("X-KDE-PluginInfo-Name", pluginName);
-    cg.writeEntry("X-KDE-ServiceTypes", "Plasma/LookAndFeel");
-    cg.writeEntry("X-KDE-PluginInfo-Author", author);
-    cg.writeEntry("X-KDE-PluginInfo-Email", email);
-    cg.writeEntry("X-KDE-PluginInfo-Website", website);
-    cg.writeEntry("X-KDE-PluginInfo-Category", "Plasma Look And Feel");
-    cg.writeEntry("X-KDE-PluginInfo-License", license);
-    cg.writeEntry("X-KDE-PluginInfo-EnabledByDefault", "true");
-    cg.writeEntry("X-KDE-PluginInfo-Version", "0.1");
-    cg.sync();
+    LnfBuilder::Metadata metadata;
+    metadata.pluginName = pluginName;
+    metadata.name = name;
+    metadata.comment = comment;
+    metadata.author = author;
+    metadata.email = email;
+    metadata.license = license;
+    metadata.website = website;
+    if (!LnfBuilder::writeMetadata(metadataPath, metadata)) {
+        qWarning() << "Impossible to write" << metadataPath;
+        emit messageRequested(ErrorLevel::Error, i18n("Impossible to write the metadata of the look and feel package"));
+        return;
+    }
 
     dumpPlasmaLayout(pluginName);
     dumpDefaultsConfigFile(pluginName);
@@ -118,48 +123,14 @@ void LnfLogic::dumpPlasmaLayout(const QString &pluginName)
 void LnfLogic::dumpDefaultsConfigFile(const QString &pluginName)
 {
     //write the defaults file, read from kde config files and save to the defaultsrc
-    KConfig defaultsConfig(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) % QLatin1Literal("/plasma/look-and-feel/") % pluginName % "/contents/defaults");
-
-    KConfigGroup defaultsConfigGroup(&defaultsConfig, "kdeglobals");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfigGroup, "KDE");
-
-    //widget style
-    KConfigGroup systemCG(KSharedConfig::openConfig(QStringLiteral("kdeglobals")), "KDE");
-    defaultsConfigGroup.writeEntry("widgetStyle", systemCG.readEntry("widgetStyle", QStringLiteral("breeze")));
-
-    //color scheme (TODO: create an in-place color scheme?)
-    defaultsConfigGroup = KConfigGroup(&defaultsConfig, "kdeglobals");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfigGroup, "General");
-    systemCG = KConfigGroup(KSharedConfig::openConfig(QStringLiteral("kdeglobals")), "General");
-    defaultsConfigGroup.writeEntry("ColorScheme", systemCG.readEntry("ColorScheme", QStringLiteral("Breeze")));
-
-    //plasma theme
-    defaultsConfigGroup = KConfigGroup(&defaultsConfig, "plasmarc");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfigGroup, "Theme");
-    systemCG = KConfigGroup(KSharedConfig::openConfig(QStringLiteral("plasmarc")), "Theme");
-    defaultsConfigGroup.writeEntry("name", systemCG.readEntry("name", QStringLiteral("default")));
-
-    //cursor theme
-    defaultsConfigGroup = KConfigGroup(&defaultsConfig, "kcminputrc");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfigGroup, "Mouse");
-    systemCG = KConfigGroup(KSharedConfig::openConfig(QStringLiteral("kcminputrc")), "Mouse");
-    defaultsConfigGroup.writeEntry("cursorTheme", systemCG.readEntry("cursorTheme", QStringLiteral("breeze_cursors")));
-
-    //KWin window switcher theme
-    systemCG = KConfigGroup(KSharedConfig::openConfig(QStringLiteral("kwinrc")), "TabBox");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfig, "kwinrc");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfigGroup, "WindowSwitcher");
-    defaultsConfigGroup.writeEntry("LayoutName", systemCG.readEntry("LayoutName", QStringLiteral("org.kde.breeze.desktop")));
-
-    defaultsConfigGroup = KConfigGroup(&defaultsConfig, "kwinrc");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfigGroup, "DesktopSwitcher");
-    defaultsConfigGroup.writeEntry("LayoutName", systemCG.readEntry("DesktopLayout", QStringLiteral("org.kde.breeze.desktop")));
-
-    systemCG = KConfigGroup(KSharedConfig::openConfig(QStringLiteral("kwinrc")), "org.kde.kdecoration2");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfig, "kwinrc");
-    defaultsConfigGroup = KConfigGroup(&defaultsConfigGroup, "org.kde.kdecoration2");
-    defaultsConfigGroup.writeEntry("library", systemCG.readEntry("library", QStringLiteral("org.kde.breeze")));
-    defaultsConfigGroup.writeEntry("theme", systemCG.readEntry("theme", QString()));
+    const QString defaultsPath = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) % QLatin1Literal("/plasma/look-and-feel/") % pluginName % "/contents/defaults";
+
+    const QVector<LnfDefaults::Entry> entries = LnfDefaults::entries();
+    if (!LnfDefaults::write(defaultsPath, entries, LnfDefaults::capture(entries))) {
+        qWarning() << "Impossible to write the defaults config file" << defaultsPath;
+        emit messageRequested(ErrorLevel::Error, i18n("Impossible to write the defaults config file"));
+        return;
+    }
 
     emit messageRequested(ErrorLevel::Info, i18n("Defaults config file saved from your current setup"));
 }
@@ -224,6 +195,8 @@ void LnfLogic::setTheme(const QString& theme)
 
     m_tempMetadata.clear();
     m_themeName = theme;
+    // it was meant for the previous theme
+    m_pendingThumbnail.clear();
     m_package.setPath(theme);
     m_needsSave = false;
     emit needsSaveChanged();
@@ -433,50 +406,72 @@ QString LnfLogic::thumbnailPath() const
     return QString();
 }
 
-void LnfLogic::processThumbnail(const QString &path)
+bool LnfLogic::isProcessingThumbnail() const
 {
-    if (path.isEmpty()) {
+    return m_thumbnail.isRunning();
+}
+
+int LnfLogic::thumbnailProgress() const
+{
+    return m_thumbnailProgress;
+}
+
+void LnfLogic::setThumbnailProgress(int progress)
+{
+    if (m_thumbnailProgress == progress) {
         return;
     }
 
-    QDir themeDir(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) % QLatin1Literal("/plasma/look-and-feel/") % m_themeName);
-    if (!themeDir.mkpath("contents/previews")) {
-        qWarning() << "Impossible to create the layouts directory in the look and feel package";
-    }
+    m_thumbnailProgress = progress;
+    emit thumbnailProgressChanged();
+}
 
-    QFile imageFile(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) % QLatin1Literal("/plasma/look-and-feel/") % m_themeName % QLatin1Literal("/contents/previews/preview.png"));
-    if (!imageFile.open(QIODevice::WriteOnly)) {
-        qWarning() << "Impossible to write to the thumbnail file";
+void LnfLogic::processThumbnail(const QString &path)
+{
+    if (path.isEmpty()) {
         return;
     }
 
-    QImage image(QUrl(path).path());
-    if (image.isNull()) {
-        qWarning() << "invalid image";
+    // decoding and scaling a big screenshot takes seconds, the last image
+    // given is processed once the current one is done
+    if (m_thumbnail.isRunning()) {
+        m_pendingThumbnail = path;
         return;
     }
-    image = image.scaledToWidth(512, Qt::SmoothTransformation);
 
-    image.save(&imageFile, "PNG"); // writes image into ba in PNG format
-    imageFile.close();
+    m_thumbnailTheme = m_themeName;
+    const QString previewsDir = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) % QLatin1Literal("/plasma/look-and-feel/") % m_thumbnailTheme % QLatin1Literal("/contents/previews");
 
-    //copy the fullscreen preview
-    QFile fullScreenImageFile(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) % QLatin1Literal("/plasma/look-and-feel/") % m_themeName % QLatin1Literal("/contents/previews/fullscreenpreview.jpg"));
-    if (!fullScreenImageFile.open(QIODevice::WriteOnly)) {
-        qWarning() << "Impossible to write to the thumbnail file";
-        return;
-    }
+    auto progress = [this](int percent) {
+        QMetaObject::invokeMethod(this, "setThumbnailProgress", Qt::QueuedConnection, Q_ARG(int, percent));
+    };
 
-    QImage fullScreenImage(QUrl(path).path());
-    if (fullScreenImage.isNull()) {
-        qWarning() << "invalid image";
-        return;
+    setThumbnailProgress(0);
+    m_thumbnail.setFuture(QtConcurrent::run(&ThumbnailWriter::write, QUrl(path).path(), previewsDir, std::function<void(int)>(progress)));
+    emit processingThumbnailChanged();
+}
+
+void LnfLogic::thumbnailFinished()
+{
+    const ThumbnailWriter::Result result = m_thumbnail.result();
+    if (!result.success) {
+        qWarning() << result.error;
+        emit messageRequested(ErrorLevel::Error, result.error);
     }
 
-    fullScreenImage.save(&fullScreenImageFile, "JPG"); // writes image into ba in PNG format
-    fullScreenImageFile.close();
+    setThumbnailProgress(100);
+    emit processingThumbnailChanged();
 
-    emit themeChanged();
+    // the previews of another theme than the one shown changed nothing here
+    if (result.success && m_thumbnailTheme == m_themeName) {
+        emit themeChanged();
+    }
+
+    if (!m_pendingThumbnail.isEmpty()) {
+        const QString path = m_pendingThumbnail;
+        m_pendingThumbnail.clear();
+        processThumbnail(path);
+    }
 }
 
 QString LnfLogic::openFile()
@@ -21,8 +21,11 @@
 #define LNFLOGIC_H
 
 #include <QAbstractListModel>
+#include <QFutureWatcher>
 #include <kpackage/package.h>
 
+#include "thumbnailwriter.h"
+
 
 class LnfListModel;
 class QDBusPendingCallWatcher;
@@ -50,6 +53,9 @@ class LnfLogic : public QObject
 
     Q_PROPERTY(bool needsSave READ needsSave NOTIFY needsSaveChanged)
 
+    Q_PROPERTY(bool processingThumbnail READ isProcessingThumbnail NOTIFY processingThumbnailChanged)
+    Q_PROPERTY(int thumbnailProgress READ thumbnailProgress NOTIFY thumbnailProgressChanged)
+
 public:
     enum ErrorLevel {
         Info,
@@ -97,12 +103,20 @@ public:
 
     QString thumbnailPath() const;
 
+    bool isProcessingThumbnail() const;
+    int thumbnailProgress() const;
+
     void dumpPlasmaLayout(const QString &pluginName);
 
     bool needsSave();
 
     Q_INVOKABLE void save();
     Q_INVOKABLE void createNewTheme(const QString &pluginName, const QString &name, const QString &comment, const QString &author, const QString &email, const QString &license, const QString &website);
+    /**
+     * Writes the previews of the current theme from the image at @p path,
+     * in a thread of the global thread pool; themeChanged() is emitted
+     * once they are written, unless another theme got selected meanwhile.
+     */
     Q_INVOKABLE void processThumbnail(const QString &path);
     Q_INVOKABLE QString openFile();
 
@@ -122,6 +136,12 @@ Q_SIGNALS:
     void licenseChanged();
     void performLayoutDumpChanged();
     void performDefaultsDumpChanged();
+    void processingThumbnailChanged();
+    void thumbnailProgressChanged();
+
+private Q_SLOTS:
+    void setThumbnailProgress(int progress);
+    void thumbnailFinished();
 
 private:
     QString m_themeName;
@@ -131,6 +151,14 @@ private:
     bool m_performLayoutDump : 1;
     bool m_performDefaultsDump : 1;
     bool m_needsSave;
+
+    QFutureWatcher<ThumbnailWriter::Result> m_thumbnail;
+    // the theme the previews being written belong to
+    QString m_thumbnailTheme;
+    // an image given for the current theme while the previous one was
+    // still being processed
+    QString m_pendingThumbnail;
+    int m_thumbnailProgress;
 };
 
 #endif // LNFLOGIC_H
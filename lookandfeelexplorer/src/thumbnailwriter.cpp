@@ -0,0 +1,155 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "thumbnailwriter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QImageReader>
+#include <QSaveFile>
+
+#include <KLocalizedString>
+
+static bool saveImage(const QImage &image, const QString &path, const char *format)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    return image.save(&file, format) && file.commit();
+}
+
+static bool copyFile(const QString &source, const QString &path)
+{
+    QFile in(source);
+    QSaveFile out(path);
+    if (!in.open(QIODevice::ReadOnly) || !out.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    while (!in.atEnd()) {
+        const QByteArray chunk = in.read(1 << 20);
+        if (chunk.isEmpty() || out.write(chunk) != chunk.size()) {
+            return false;
+        }
+    }
+
+    return out.commit();
+}
+
+// averages blocks of factor x factor pixels, which is far cheaper than a
+// smooth scale of the whole image and loses nothing the final one keeps
+static QImage boxDownscale(const QImage &source, int factor)
+{
+    const QImage image = source.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QImage scaled(image.width() / factor, image.height() / factor, QImage::Format_ARGB32_Premultiplied);
+    const int area = factor * factor;
+
+    for (int y = 0; y < scaled.height(); ++y) {
+        QRgb *target = reinterpret_cast<QRgb *>(scaled.scanLine(y));
+        for (int x = 0; x < scaled.width(); ++x) {
+            int red = 0, green = 0, blue = 0, alpha = 0;
+            for (int dy = 0; dy < factor; ++dy) {
+                const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(y * factor + dy)) + x * factor;
+                for (int dx = 0; dx < factor; ++dx) {
+                    red += qRed(line[dx]);
+                    green += qGreen(line[dx]);
+                    blue += qBlue(line[dx]);
+                    alpha += qAlpha(line[dx]);
+                }
+            }
+            target[x] = qRgba(red / area, green / area, blue / area, alpha / area);
+        }
+    }
+
+    return scaled;
+}
+
+static QImage previewImage(const QImage &image)
+{
+    QImage preview = image;
+    // the box filter gets it close, leaving a small smooth scale
+    const int factor = preview.width() / (2 * ThumbnailWriter::s_previewWidth);
+    if (factor >= 2) {
+        preview = boxDownscale(preview, factor);
+    }
+    return preview.scaledToWidth(ThumbnailWriter::s_previewWidth, Qt::SmoothTransformation);
+}
+
+ThumbnailWriter::Result ThumbnailWriter::write(const QString &source, const QString &previewsDir,
+                                               const std::function<void(int)> &progress)
+{
+    auto report = [&progress](int percent) {
+        if (progress) {
+            progress(percent);
+        }
+    };
+
+    Result result;
+
+    if (!QDir().mkpath(previewsDir)) {
+        result.error = i18n("Impossible to create the previews directory in the look and feel package");
+        return result;
+    }
+
+    QImageReader reader(source);
+    const QByteArray format = reader.format();
+    const QSize size = reader.size();
+    const bool jpeg = format == "jpeg" || format == "jpg";
+
+    QImage preview;
+    QImage fullImage;
+    if (jpeg && size.width() > s_previewWidth && reader.supportsOption(QImageIOHandler::ScaledSize)) {
+        // the jpeg decoder scales while reading, so the full image is never
+        // decoded; the fullscreen preview is the file itself
+        reader.setScaledSize(QSize(s_previewWidth, qMax(1, size.height() * s_previewWidth / size.width())));
+        preview = reader.read();
+    } else {
+        fullImage = reader.read();
+        if (!fullImage.isNull()) {
+            preview = previewImage(fullImage);
+        }
+    }
+
+    if (preview.isNull()) {
+        result.error = i18n("The image could not be read");
+        return result;
+    }
+    report(40);
+
+    if (!saveImage(preview, previewsDir % QLatin1String("/preview.png"), "PNG")) {
+        result.error = i18n("Impossible to write to the thumbnail file");
+        return result;
+    }
+    report(60);
+
+    // a jpeg is copied as it is instead of being encoded once more
+    const QString fullScreenPath = previewsDir % QLatin1String("/fullscreenpreview.jpg");
+    const bool written = jpeg ? copyFile(source, fullScreenPath) : saveImage(fullImage, fullScreenPath, "JPG");
+    if (!written) {
+        result.error = i18n("Impossible to write to the thumbnail file");
+        return result;
+    }
+    report(100);
+
+    result.success = true;
+    return result;
+}
@@ -0,0 +1,57 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef THUMBNAILWRITER_H
+#define THUMBNAILWRITER_H
+
+#include <QString>
+
+#include <functional>
+
+/**
+ * Writes the previews of a look and feel package from a screenshot: the
+ * preview.png shown in the list and the fullscreenpreview.jpg.
+ *
+ * Nothing in here touches the GUI, so it can run in any thread. A jpeg is
+ * only decoded at the size of the preview and copied as the fullscreen one.
+ */
+class ThumbnailWriter
+{
+public:
+    // the width of preview.png
+    static const int s_previewWidth = 512;
+
+    struct Result {
+        bool success = false;
+        // a translated description of what went wrong
+        QString error;
+    };
+
+    /**
+     * Writes both previews from the image at @p source into @p previewsDir.
+     * Each file is replaced as a whole, never left half written.
+     *
+     * @param progress called with a percentage after each step, from the
+     * thread this runs in
+     */
+    static Result write(const QString &source, const QString &previewsDir,
+                        const std::function<void(int)> &progress = std::function<void(int)>());
+};
+
+#endif // THUMBNAILWRITER_H
@@ -0,0 +1,197 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "packagecatalogue.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QtConcurrentRun>
+
+#include <KConfigGroup>
+#include <KDesktopFile>
+
+// several files of a package are usually written in one go
+static const int s_refreshDelay = 500;
+
+PackageCatalogue::PackageCatalogue(const QString &type, QObject *parent)
+    : QObject(parent),
+      m_type(type),
+      m_refreshAgain(false)
+{
+    connect(&m_refresh, SIGNAL(finished()), this, SLOT(refreshFinished()));
+
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(s_refreshDelay);
+    connect(&m_refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+    connect(&m_watcher, SIGNAL(directoryChanged(QString)), &m_refreshTimer, SLOT(start()));
+    connect(&m_watcher, SIGNAL(fileChanged(QString)), &m_refreshTimer, SLOT(start()));
+}
+
+PackageCatalogue::~PackageCatalogue()
+{
+    m_refresh.waitForFinished();
+}
+
+QVector<PackageCatalogue::Package> PackageCatalogue::packages() const
+{
+    QVector<Package> visible;
+    visible.reserve(m_packages.count());
+    foreach (const Package &package, m_packages) {
+        if (!package.noDisplay) {
+            visible << package;
+        }
+    }
+
+    return visible;
+}
+
+void PackageCatalogue::scan()
+{
+    // a refresh still running would deliver an older result than this scan
+    m_refresh.waitForFinished();
+    m_refresh.setFuture(QFuture<QVector<Package> >());
+    m_refreshAgain = false;
+
+    apply(scanPackages(m_type, m_cache));
+}
+
+void PackageCatalogue::refresh()
+{
+    if (m_refresh.isRunning()) {
+        m_refreshAgain = true;
+        return;
+    }
+
+    m_refresh.setFuture(QtConcurrent::run(&PackageCatalogue::scanPackages, m_type, m_cache));
+}
+
+void PackageCatalogue::refreshFinished()
+{
+    if (m_refresh.future().resultCount() > 0) {
+        apply(m_refresh.result());
+    }
+
+    if (m_refreshAgain) {
+        m_refreshAgain = false;
+        refresh();
+    }
+}
+
+QVector<PackageCatalogue::Package> PackageCatalogue::scanPackages(const QString &type, const QHash<QString, Package> &cache)
+{
+    QVector<Package> packages;
+
+    const QStringList dirs = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, type, QStandardPaths::LocateDirectory);
+    foreach (const QString &dir, dirs) {
+        const QStringList entries = QDir(dir).entryList(QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot);
+        foreach (const QString &entry, entries) {
+            const QString metadataPath = dir % QLatin1Char('/') % entry % QLatin1String("/metadata.desktop");
+
+            // one stat tells both whether there is a package and whether
+            // what is known about it is still current
+            const QFileInfo info(metadataPath);
+            if (!info.exists()) {
+                continue;
+            }
+
+            const QDateTime modified = info.lastModified();
+            auto it = cache.constFind(metadataPath);
+            if (it != cache.constEnd() && it->modified == modified) {
+                packages << *it;
+            } else {
+                packages << readPackage(metadataPath, modified);
+            }
+        }
+    }
+
+    return packages;
+}
+
+PackageCatalogue::Package PackageCatalogue::readPackage(const QString &metadataPath, const QDateTime &modified)
+{
+    Package package;
+    package.metadataPath = metadataPath;
+    package.root = metadataPath.left(metadataPath.lastIndexOf(QLatin1Char('/')));
+    package.pluginName = package.root.mid(package.root.lastIndexOf(QLatin1Char('/')) + 1);
+    package.modified = modified;
+
+    KDesktopFile df(metadataPath);
+    package.noDisplay = df.noDisplay();
+    package.name = df.readName();
+    if (package.name.isEmpty()) {
+        package.name = package.pluginName;
+    }
+    package.comment = df.readComment();
+    package.author = df.desktopGroup().readEntry("X-KDE-PluginInfo-Author", QString());
+    package.version = df.desktopGroup().readEntry("X-KDE-PluginInfo-Version", QString());
+
+    return package;
+}
+
+void PackageCatalogue::apply(const QVector<Package> &packages)
+{
+    bool changed = packages.count() != m_packages.count();
+    for (int i = 0; !changed && i < packages.count(); ++i) {
+        changed = packages.at(i).metadataPath != m_packages.at(i).metadataPath
+                  || packages.at(i).modified != m_packages.at(i).modified;
+    }
+
+    // packages which are gone are dropped from the cache as well
+    m_cache.clear();
+    foreach (const Package &package, packages) {
+        m_cache.insert(package.metadataPath, package);
+    }
+
+    m_packages = packages;
+    watch();
+
+    if (changed) {
+        emit packagesChanged();
+    }
+}
+
+void PackageCatalogue::watch()
+{
+    QStringList paths = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, m_type, QStandardPaths::LocateDirectory);
+    foreach (const Package &package, m_packages) {
+        paths << package.metadataPath;
+    }
+
+    const QStringList watched = m_watcher.directories() + m_watcher.files();
+    QStringList stale;
+    foreach (const QString &path, watched) {
+        if (!paths.contains(path)) {
+            stale << path;
+        }
+    }
+    if (!stale.isEmpty()) {
+        m_watcher.removePaths(stale);
+    }
+
+    QStringList added;
+    foreach (const QString &path, paths) {
+        if (!watched.contains(path)) {
+            added << path;
+        }
+    }
+    if (!added.isEmpty()) {
+        m_watcher.addPaths(added);
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef PACKAGECATALOGUE_H
+#define PACKAGECATALOGUE_H
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * The packages of one kind installed in the GenericDataLocation
+ * directories, e.g. all the "plasma/desktoptheme" ones, with the metadata
+ * from their metadata.desktop.
+ *
+ * The metadata of a package is kept together with the modification time of
+ * its metadata.desktop, so a scan only reads the files which changed since
+ * the last one and otherwise just lists the directories.
+ *
+ * The package directories and metadata files are watched; after a change
+ * they are scanned again in the background and packagesChanged() is emitted
+ * if anything turned out to be different.
+ */
+class PackageCatalogue : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Package {
+        QString metadataPath;
+        // the directory of the package
+        QString root;
+        // the name of the package directory
+        QString pluginName;
+        QString name;
+        QString comment;
+        QString author;
+        QString version;
+        bool noDisplay = false;
+        QDateTime modified;
+    };
+
+    /**
+     * @param type the directory of the packages below GenericDataLocation,
+     * such as "plasma/look-and-feel"
+     */
+    explicit PackageCatalogue(const QString &type, QObject *parent = nullptr);
+    ~PackageCatalogue() override;
+
+    /**
+     * @return the packages which are not hidden, in the order of the data
+     * directories and their entries
+     */
+    QVector<Package> packages() const;
+
+    /**
+     * Scans the package directories right away, for callers which need the
+     * result at once, e.g. after installing a package themselves.
+     */
+    void scan();
+
+public Q_SLOTS:
+    /**
+     * Scans the package directories in a thread of the global thread pool.
+     */
+    void refresh();
+
+Q_SIGNALS:
+    void packagesChanged();
+
+private Q_SLOTS:
+    void refreshFinished();
+
+private:
+    static QVector<Package> scanPackages(const QString &type, const QHash<QString, Package> &cache);
+    static Package readPackage(const QString &metadataPath, const QDateTime &modified);
+    void apply(const QVector<Package> &packages);
+    void watch();
+
+    QString m_type;
+    QVector<Package> m_packages;
+    QHash<QString, Package> m_cache;
+    QFutureWatcher<QVector<Package> > m_refresh;
+    bool m_refreshAgain;
+    QFileSystemWatcher m_watcher;
+    QTimer m_refreshTimer;
+};
+
+#endif // PACKAGECATALOGUE_H
@@ -0,0 +1,185 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <QTest>
+
+#include <QBuffer>
+#include <QDirIterator>
+#include <QStandardPaths>
+
+#include <QXmlSimpleReader>
+#include <QXmlDefaultHandler>
+#include <QXmlInputSource>
+
+#include <KCompressionDevice>
+
+#include "svgelementcache.h"
+
+// the SAX handler ThemeModel used before, to compare against
+class IconsParserHandler : public QXmlDefaultHandler
+{
+public:
+    bool startElement(const QString &namespaceURI, const QString &localName,
+                      const QString &qName, const QXmlAttributes &atts) override
+    {
+        Q_UNUSED(namespaceURI)
+        Q_UNUSED(localName)
+        Q_UNUSED(qName)
+
+        const QString id = atts.value("id");
+        if (!id.isEmpty() && !id.contains(QRegExp("\\d\\d$")) &&
+            id != "base" && !id.contains("layer")) {
+            m_ids << id;
+        }
+        if (id.endsWith("-center") && !id.contains("hint-")) {
+            m_prefixes << id.mid(0, id.length() - 7);
+        }
+        return true;
+    }
+
+    QStringList m_ids;
+    QStringList m_prefixes;
+};
+
+class SvgElementsTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static SvgElements parseWithSax(const QByteArray &svg)
+    {
+        QBuffer buffer;
+        buffer.setData(svg);
+        buffer.open(QIODevice::ReadOnly);
+
+        QXmlSimpleReader reader;
+        IconsParserHandler handler;
+        reader.setContentHandler(&handler);
+        QXmlInputSource source(&buffer);
+        reader.parse(&source);
+
+        SvgElements elements;
+        elements.ids = handler.m_ids;
+        elements.prefixes = handler.m_prefixes;
+        return elements;
+    }
+
+    static SvgElements parseWithStreamReader(const QByteArray &svg)
+    {
+        QBuffer buffer;
+        buffer.setData(svg);
+        buffer.open(QIODevice::ReadOnly);
+        return SvgElementCache::parse(&buffer);
+    }
+
+    // the uncompressed svgs of the stock Breeze theme
+    QHash<QString, QByteArray> m_breeze;
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        const QString themeDir = QStandardPaths::locate(QStandardPaths::GenericDataLocation,
+                                                        QStringLiteral("plasma/desktoptheme/default"),
+                                                        QStandardPaths::LocateDirectory);
+        if (themeDir.isEmpty()) {
+            return;
+        }
+
+        QDirIterator it(themeDir, QStringList() << "*.svgz" << "*.svg", QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const QString path = it.next();
+            KCompressionDevice file(path, KCompressionDevice::GZip);
+            if (file.open(QIODevice::ReadOnly)) {
+                m_breeze.insert(path, file.readAll());
+            }
+        }
+    }
+
+    void testElements()
+    {
+        const QByteArray svg =
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<svg xmlns=\"http://www.w3.org/2000/svg\" id=\"svg2\">\n"
+            "  <g id=\"layer1\"><rect id=\"base\"/><rect id=\"rect4512\"/></g>\n"
+            "  <rect id=\"normal-center\"/><rect id=\"normal-top\"/>\n"
+            "  <rect id=\"hint-stretch-center\"/>\n"
+            "  <rect id=\"shadow-center\"/>\n"
+            "  <path/>\n"
+            "</svg>\n";
+
+        const SvgElements elements = parseWithStreamReader(svg);
+        QCOMPARE(elements.ids, QStringList() << "svg2" << "normal-center" << "normal-top"
+                                             << "hint-stretch-center" << "shadow-center");
+        QCOMPARE(elements.prefixes, QStringList() << "normal" << "shadow");
+    }
+
+    void testMatchesSaxParser_data()
+    {
+        QTest::addColumn<QByteArray>("svg");
+
+        if (m_breeze.isEmpty()) {
+            QSKIP("The Breeze Plasma theme is not installed");
+        }
+
+        for (auto it = m_breeze.constBegin(); it != m_breeze.constEnd(); ++it) {
+            QTest::newRow(qPrintable(it.key())) << it.value();
+        }
+    }
+
+    void testMatchesSaxParser()
+    {
+        QFETCH(QByteArray, svg);
+
+        const SvgElements expected = parseWithSax(svg);
+        const SvgElements actual = parseWithStreamReader(svg);
+        QCOMPARE(actual.ids, expected.ids);
+        QCOMPARE(actual.prefixes, expected.prefixes);
+    }
+
+    void benchmarkSaxParser()
+    {
+        if (m_breeze.isEmpty()) {
+            QSKIP("The Breeze Plasma theme is not installed");
+        }
+
+        QBENCHMARK {
+            foreach (const QByteArray &svg, m_breeze) {
+                parseWithSax(svg);
+            }
+        }
+    }
+
+    void benchmarkStreamReader()
+    {
+        if (m_breeze.isEmpty()) {
+            QSKIP("The Breeze Plasma theme is not installed");
+        }
+
+        QBENCHMARK {
+            foreach (const QByteArray &svg, m_breeze) {
+                parseWithStreamReader(svg);
+            }
+        }
+    }
+};
+
+QTEST_MAIN(SvgElementsTest)
+
+#include "svgelementstest.moc"
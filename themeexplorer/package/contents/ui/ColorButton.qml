@@ -31,6 +31,11 @@ Button {
         colorDialog.open();
     }
     property alias color: colorRect.color;
+    onColorChanged: {
+        if (themeModel.colorEditor.previewing) {
+            dialog.applyColors();
+        }
+    }
 
     Rectangle {
         id: colorRect
@@ -73,6 +73,11 @@ Dialog {
             complementaryBackgroundColor = themeModel.colorEditor.complementaryBackgroundColor;
             complementaryHoverColor = themeModel.colorEditor.complementaryHoverColor;
             complementaryFocusColor = themeModel.colorEditor.complementaryFocusColor;
+
+            themeModel.colorEditor.startPreview();
+        } else {
+            // does nothing once saved
+            themeModel.colorEditor.cancelPreview();
         }
     }
     ColorDialog {
@@ -81,9 +86,24 @@ Dialog {
         showAlphaChannel: false
         title: i18n("Select Color")
         property Item activeButton
+        property color startColor
+        onVisibleChanged: {
+            if (visible) {
+                startColor = activeButton.color;
+                color = startColor;
+            }
+        }
+        onCurrentColorChanged: {
+            if (visible) {
+                activeButton.color = currentColor;
+            }
+        }
         onAccepted: {
             activeButton.color = color;
         }
+        onRejected: {
+            activeButton.color = startColor;
+        }
     }
     contentItem: Rectangle {
         implicitWidth:  units.gridUnit * 50
@@ -189,6 +209,11 @@ Dialog {
                     }
                 }
             }
+            Label {
+                Layout.fillWidth: true
+                wrapMode: Text.WordWrap
+                text: i18n("While this dialog is open, the explorer shows the background, view background and text colors being edited. The other colors only show in the preview above until they are saved.")
+            }
             ScrollView {
                 id: scroll
                 Layout.fillWidth: true
@@ -346,7 +371,8 @@ Dialog {
         }
     }
 
-    onAccepted: {
+    // while previewing, the explorer shows every change right away
+    function applyColors() {
         themeModel.colorEditor.textColor = textColor;
         themeModel.colorEditor.backgroundColor = backgroundColor;
         themeModel.colorEditor.highlightColor = highlightColor;
@@ -367,7 +393,10 @@ Dialog {
         themeModel.colorEditor.complementaryBackgroundColor = complementaryBackgroundColor;
         themeModel.colorEditor.complementaryHoverColor = complementaryHoverColor;
         themeModel.colorEditor.complementaryFocusColor = complementaryFocusColor;
+    }
 
+    onAccepted: {
+        applyColors();
         themeModel.colorEditor.save();
     }
 }
@@ -32,7 +32,7 @@ Item {
             margins: units.gridUnit
         }
         radius: 3
-        color: theme.backgroundColor
+        color: root.previewTheme.backgroundColor
         opacity: 0.6
     }
 
@@ -54,6 +54,7 @@ Item {
                 checked: false
             }
             PlasmaComponents.Label {
+                color: root.previewTheme.textColor
                 anchors.horizontalCenter: parent.horizontalCenter
                 text: model.imagePath
                 visible: width < background.width
@@ -35,7 +35,7 @@ Item {
             margins: units.gridUnit
         }
         radius: 3
-        color: theme.backgroundColor
+        color: root.previewTheme.backgroundColor
         opacity: 0.6
     }
     Flow {
@@ -53,6 +53,7 @@ Item {
                 imagePath: delegateRoot.imagePath
                 prefix: modelData
                 PlasmaComponents.Label {
+                    color: root.previewTheme.textColor
                     anchors.centerIn: parent
                     text: modelData
                     visible: width < parent.width
@@ -76,6 +77,7 @@ Item {
     }
 
     PlasmaComponents.Label {
+        color: root.previewTheme.textColor
         anchors {
             horizontalCenter: background.horizontalCenter
             bottom: background.bottom
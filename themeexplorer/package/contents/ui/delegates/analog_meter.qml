@@ -86,6 +86,7 @@ Item {
         height: naturalSize.height * centerScrew.svgScale
     }
     PlasmaComponents.Label {
+        color: root.previewTheme.textColor
         anchors {
             horizontalCenter: parent.horizontalCenter
             top: face.bottom
@@ -68,6 +68,7 @@ Item {
     }
 
     PlasmaComponents.Label {
+        color: root.previewTheme.textColor
         anchors.centerIn: parent
         text: model.imagePath
         visible: width < marginsRectangle.width
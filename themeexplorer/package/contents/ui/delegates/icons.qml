@@ -33,7 +33,7 @@ Item {
             margins: units.gridUnit
         }
         radius: 3
-        color: theme.backgroundColor
+        color: root.previewTheme.backgroundColor
         opacity: 0.6
     }
 
@@ -61,6 +61,7 @@ Item {
     }
 
     PlasmaComponents.Label {
+        color: root.previewTheme.textColor
         anchors {
             horizontalCenter: background.horizontalCenter
             bottom: background.bottom
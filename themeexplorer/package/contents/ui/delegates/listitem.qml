@@ -64,6 +64,7 @@ Item {
                         visible: root.showMargins
                     }
                     PlasmaComponents.Label {
+                        color: root.previewTheme.textColor
                         anchors.centerIn: parent
                         text: parent.prefix
                     }
@@ -83,6 +84,7 @@ Item {
     }
 
     PlasmaComponents.Label {
+        color: root.previewTheme.textColor
         id: label
         anchors {
             horizontalCenter: parent.horizontalCenter
@@ -41,7 +41,7 @@ Item {
             margins: units.gridUnit
         }
         radius: 3
-        color: theme.backgroundColor
+        color: root.previewTheme.backgroundColor
         opacity: 0.6
     }
 
@@ -203,6 +203,7 @@ Item {
     }
 
     PlasmaComponents.Label {
+        color: root.previewTheme.textColor
         anchors.centerIn: parent
         text: model.imagePath
         visible: width < marginsRectangle.width
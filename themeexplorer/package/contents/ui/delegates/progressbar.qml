@@ -32,7 +32,7 @@ Item {
             margins: units.gridUnit
         }
         radius: 3
-        color: theme.backgroundColor
+        color: root.previewTheme.backgroundColor
         opacity: 0.6
     }
     Column {
@@ -46,6 +46,7 @@ Item {
             indeterminate: true
         }
         PlasmaComponents.Label {
+            color: root.previewTheme.textColor
             anchors.horizontalCenter: parent.horizontalCenter
             text: model.imagePath
             visible: width < background.width
@@ -33,7 +33,7 @@ Item {
             margins: units.gridUnit
         }
         radius: 3
-        color: theme.backgroundColor
+        color: root.previewTheme.backgroundColor
         opacity: 0.6
     }
     Column {
@@ -47,6 +47,7 @@ Item {
             }
         }
         PlasmaComponents.Label {
+            color: root.previewTheme.textColor
             anchors.horizontalCenter: parent.horizontalCenter
             text: model.imagePath
             visible: width < background.width
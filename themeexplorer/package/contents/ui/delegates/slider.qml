@@ -32,7 +32,7 @@ Item {
             margins: units.gridUnit
         }
         radius: 3
-        color: theme.backgroundColor
+        color: root.previewTheme.backgroundColor
         opacity: 0.6
     }
     Column {
@@ -42,6 +42,7 @@ Item {
             value: 0.5
         }
         PlasmaComponents.Label {
+            color: root.previewTheme.textColor
             anchors.horizontalCenter: parent.horizontalCenter
             text: model.imagePath
             visible: width < background.width
@@ -30,6 +30,9 @@ ApplicationWindow {
     visible: true
     property int iconSize: iconSizeSlider.value
     property alias showMargins: showMarginsCheckBox.checked
+    // while the color editor is open the colors being tried out, otherwise
+    // the theme ones; both have the same color properties
+    readonly property QtObject previewTheme: themeModel.colorEditor.previewing ? themeModel.colorEditor : theme
 
     Shortcut {
         sequence: StandardKey.Quit
@@ -67,6 +70,9 @@ ApplicationWindow {
                     themeModel.theme = themeModel.themeList.get(currentIndex).packageNameRole;
                 }
             }
+            Label {
+                text: i18n("%1 of %2 images themed", themeModel.overriddenCount, themeModel.elementCount)
+            }
             ToolButton {
                 text: i18n("Open Folder")
                 iconName: "document-open-folder"
@@ -149,7 +155,7 @@ ApplicationWindow {
 
     Rectangle {
         anchors.fill: scrollView
-        color: theme.viewBackgroundColor
+        color: root.previewTheme.viewBackgroundColor
     }
     ScrollView {
         id: scrollView
@@ -189,6 +195,12 @@ ApplicationWindow {
                     z: -1
                     anchors.fill: parent
                     source: Qt.resolvedUrl("delegates/" + model.delegate + ".qml")
+                    //reload the svgs once the file got edited
+                    property int revision: model.revision
+                    onRevisionChanged: {
+                        active = false;
+                        active = true;
+                    }
                 }
                 Rectangle {
                     anchors {
@@ -242,6 +254,11 @@ ApplicationWindow {
                 Layout.fillWidth: true
                 Layout.minimumHeight: width
                 source: Qt.resolvedUrl("delegates/" + model.delegate + ".qml")
+                property int revision: model.revision
+                onRevisionChanged: {
+                    active = false;
+                    active = true;
+                }
             }
             Item {
                 Layout.fillWidth: true
@@ -262,13 +279,19 @@ ApplicationWindow {
                 text: view.currentItem.modelData.usesFallback ? i18n("Missing from this theme") : i18n("Present in this theme")
                 wrapMode: Text.WordWrap
             }
+            Label {
+                Layout.fillWidth: true
+                visible: !view.currentItem.modelData.usesFallback
+                text: i18n("File size: %1 KiB", Math.ceil(view.currentItem.modelData.fileSize / 1024))
+                wrapMode: Text.WordWrap
+            }
             CheckBox {
                 id: showMarginsCheckBox
                 text: i18n("Show Margins")
             }
             Button {
                 text: view.currentItem.modelData.usesFallback ? i18n("Create with Editor...") : i18n("Open In Editor...")
-                enabled: view.currentItem.modelData.isWritable
+                enabled: view.currentItem.modelData.isWritable && !themeModel.preparingEdit
                 Layout.alignment: Qt.AlignHCenter
                 onClicked: {
                     print(view.currentItem.modelData.svgAbsolutePath)
@@ -276,6 +299,13 @@ ApplicationWindow {
                     //Qt.openUrlExternally(view.currentItem.modelData.svgAbsolutePath)
                 }
             }
+            ProgressBar {
+                Layout.fillWidth: true
+                visible: themeModel.preparingEdit
+                minimumValue: 0
+                maximumValue: 100
+                value: themeModel.editProgress
+            }
             Slider {
                 id: iconSizeSlider
                 Layout.fillWidth: true
@@ -26,7 +26,8 @@
 #include <KConfigGroup>
 
 ColorEditor::ColorEditor(QObject *parent)
-    : QObject(parent)
+    : QObject(parent),
+      m_previewing(false)
 {
 }
 
@@ -34,76 +35,109 @@ ColorEditor::~ColorEditor()
 {
 }
 
-void ColorEditor::load()
-{
-    const QString colorsFile = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/plasma/desktoptheme/" + m_theme + "/colors";
+const ColorEditor::ColorEntry ColorEditor::s_colorEntries[] = {
+    {"Colors:Window", "ForegroundNormal", &ColorEditor::m_textColor, &ColorEditor::textColorChanged},
+    {"Colors:Window", "DecorationHover", &ColorEditor::m_highlightColor, &ColorEditor::highlightColorChanged},
+    {"Colors:Window", "BackgroundNormal", &ColorEditor::m_backgroundColor, &ColorEditor::backgroundColorChanged},
+    {"Colors:Window", "ForegroundLink", &ColorEditor::m_linkColor, &ColorEditor::linkColorChanged},
+    {"Colors:Window", "ForegroundVisited", &ColorEditor::m_visitedLinkColor, &ColorEditor::visitedLinkColorChanged},
+    {"Colors:Button", "ForegroundNormal", &ColorEditor::m_buttonTextColor, &ColorEditor::buttonTextColorChanged},
+    {"Colors:Button", "BackgroundNormal", &ColorEditor::m_buttonBackgroundColor, &ColorEditor::buttonBackgroundColorChanged},
+    {"Colors:Button", "DecorationHover", &ColorEditor::m_buttonHoverColor, &ColorEditor::buttonHoverColorChanged},
+    {"Colors:Button", "DecorationFocus", &ColorEditor::m_buttonFocusColor, &ColorEditor::buttonFocusColorChanged},
+    {"Colors:View", "ForegroundNormal", &ColorEditor::m_viewTextColor, &ColorEditor::viewTextColorChanged},
+    {"Colors:View", "BackgroundNormal", &ColorEditor::m_viewBackgroundColor, &ColorEditor::viewBackgroundColorChanged},
+    {"Colors:View", "DecorationHover", &ColorEditor::m_viewHoverColor, &ColorEditor::viewHoverColorChanged},
+    {"Colors:View", "DecorationFocus", &ColorEditor::m_viewFocusColor, &ColorEditor::viewFocusColorChanged},
+    {"Colors:Complementary", "ForegroundNormal", &ColorEditor::m_complementaryTextColor, &ColorEditor::complementaryTextColorChanged},
+    {"Colors:Complementary", "BackgroundNormal", &ColorEditor::m_complementaryBackgroundColor, &ColorEditor::complementaryBackgroundColorChanged},
+    {"Colors:Complementary", "DecorationHover", &ColorEditor::m_complementaryHoverColor, &ColorEditor::complementaryHoverColorChanged},
+    {"Colors:Complementary", "DecorationFocus", &ColorEditor::m_complementaryFocusColor, &ColorEditor::complementaryFocusColorChanged},
+};
 
-    KConfig c(colorsFile);
+QString ColorEditor::colorsFile() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/plasma/desktoptheme/" + m_theme + "/colors";
+}
 
-    KConfigGroup cg(&c, "Colors:Window");
+void ColorEditor::load()
+{
+    KConfig c(colorsFile());
 
-    m_textColor = cg.readEntry("ForegroundNormal", QColor());
-    m_highlightColor = cg.readEntry("DecorationHover", QColor());
-    m_backgroundColor = cg.readEntry("BackgroundNormal", QColor());
-    m_linkColor = cg.readEntry("ForegroundLink", QColor());
-    m_visitedLinkColor = cg.readEntry("ForegroundVisited", QColor());
+    bool changed = false;
+    for (const ColorEntry &entry : s_colorEntries) {
+        const QColor color = KConfigGroup(&c, entry.group).readEntry(entry.key, QColor());
+        if (color != this->*entry.color) {
+            this->*entry.color = color;
+            emit (this->*entry.changed)();
+            changed = true;
+        }
+    }
 
-    cg = KConfigGroup(&c, "Colors:Button");
-    m_buttonTextColor = cg.readEntry("ForegroundNormal", QColor());
-    m_buttonBackgroundColor = cg.readEntry("BackgroundNormal", QColor());
-    m_buttonHoverColor = cg.readEntry("DecorationHover", QColor());
-    m_buttonFocusColor = cg.readEntry("DecorationFocus", QColor());
+    if (changed) {
+        emit colorsChanged();
+    }
+}
 
-    cg = KConfigGroup(&c, "Colors:View");
-    m_viewTextColor = cg.readEntry("ForegroundNormal", QColor());
-    m_viewBackgroundColor = cg.readEntry("BackgroundNormal", QColor());
-    m_viewHoverColor = cg.readEntry("DecorationHover", QColor());
-    m_viewFocusColor = cg.readEntry("DecorationFocus", QColor());
+bool ColorEditor::isPreviewing() const
+{
+    return m_previewing;
+}
 
-    cg = KConfigGroup(&c, "Colors:Complementary");
-    m_complementaryTextColor = cg.readEntry("ForegroundNormal", QColor());
-    m_complementaryBackgroundColor = cg.readEntry("BackgroundNormal", QColor());
-    m_complementaryHoverColor = cg.readEntry("DecorationHover", QColor());
-    m_complementaryFocusColor = cg.readEntry("DecorationFocus", QColor());
+void ColorEditor::startPreview()
+{
+    m_previewStart.clear();
+    for (const ColorEntry &entry : s_colorEntries) {
+        m_previewStart << this->*entry.color;
+    }
 
-    emit colorsChanged();
+    if (!m_previewing) {
+        m_previewing = true;
+        emit previewingChanged();
+    }
 }
 
-void ColorEditor::save()
+void ColorEditor::cancelPreview()
 {
-    const QString colorsFile = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/plasma/desktoptheme/" + m_theme + "/colors";
+    if (!m_previewing) {
+        return;
+    }
 
-    KConfig c(colorsFile);
+    int i = 0;
+    for (const ColorEntry &entry : s_colorEntries) {
+        setColor(entry.color, m_previewStart.at(i++), entry.changed);
+    }
 
-    KConfigGroup cg(&c, "Colors:Window");
+    m_previewStart.clear();
+    m_previewing = false;
+    emit previewingChanged();
+}
 
-    cg.writeEntry("ForegroundNormal", m_textColor);
-    cg.writeEntry("DecorationHover", m_highlightColor);
-    cg.writeEntry("BackgroundNormal", m_backgroundColor);
-    cg.writeEntry("ForegroundLink", m_linkColor);
-    cg.writeEntry("ForegroundVisited", m_visitedLinkColor);
-    cg.sync();
+void ColorEditor::save()
+{
+    // every sync rewrites the whole file, so there is only one
+    KConfig c(colorsFile());
+    for (const ColorEntry &entry : s_colorEntries) {
+        KConfigGroup(&c, entry.group).writeEntry(entry.key, this->*entry.color);
+    }
+    c.sync();
 
-    cg = KConfigGroup(&c, "Colors:Button");
-    cg.writeEntry("ForegroundNormal", m_buttonTextColor);
-    cg.writeEntry("BackgroundNormal", m_buttonBackgroundColor);
-    cg.writeEntry("DecorationHover", m_buttonHoverColor);
-    cg.writeEntry("DecorationFocus", m_buttonFocusColor);
-    cg.sync();
+    if (m_previewing) {
+        m_previewStart.clear();
+        m_previewing = false;
+        emit previewingChanged();
+    }
+}
 
-    cg = KConfigGroup(&c, "Colors:View");
-    cg.writeEntry("ForegroundNormal", m_viewTextColor);
-    cg.writeEntry("BackgroundNormal", m_viewBackgroundColor);
-    cg.writeEntry("DecorationHover", m_viewHoverColor);
-    cg.writeEntry("DecorationFocus", m_viewFocusColor);
-    cg.sync();
+void ColorEditor::setColor(QColor ColorEditor::*member, const QColor &color, void (ColorEditor::*changed)())
+{
+    if (color == this->*member) {
+        return;
+    }
 
-    cg = KConfigGroup(&c, "Colors:Complementary");
-    cg.writeEntry("ForegroundNormal", m_complementaryTextColor);
-    cg.writeEntry("BackgroundNormal", m_complementaryBackgroundColor);
-    cg.writeEntry("DecorationHover", m_complementaryHoverColor);
-    cg.writeEntry("DecorationFocus", m_complementaryFocusColor);
-    cg.sync();
+    this->*member = color;
+    emit (this->*changed)();
+    emit colorsChanged();
 }
 
 QString ColorEditor::theme() const
@@ -117,6 +151,13 @@ void ColorEditor::setTheme(const QString &theme)
         return;
     }
 
+    // what was tried out belongs to the previous theme
+    if (m_previewing) {
+        m_previewStart.clear();
+        m_previewing = false;
+        emit previewingChanged();
+    }
+
     m_theme = theme;
     emit themeChanged();
     load();
@@ -130,12 +171,7 @@ QColor ColorEditor::textColor() const
 
 void ColorEditor::setTextColor(const QColor &color)
 {
-    if (color == m_textColor) {
-        return;
-    }
-
-    m_textColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_textColor, color, &ColorEditor::textColorChanged);
 }
 
 
@@ -146,12 +182,7 @@ QColor ColorEditor::highlightColor() const
 
 void ColorEditor::setHighlightColor(const QColor &color)
 {
-    if (color == m_highlightColor) {
-        return;
-    }
-
-    m_highlightColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_highlightColor, color, &ColorEditor::highlightColorChanged);
 }
 
 
@@ -162,12 +193,7 @@ QColor ColorEditor::backgroundColor() const
 
 void ColorEditor::setBackgroundColor(const QColor &color)
 {
-    if (color == m_backgroundColor) {
-        return;
-    }
-
-    m_backgroundColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_backgroundColor, color, &ColorEditor::backgroundColorChanged);
 }
 
 
@@ -178,12 +204,7 @@ QColor ColorEditor::buttonTextColor() const
 
 void ColorEditor::setButtonTextColor(const QColor &color)
 {
-    if (color == m_buttonTextColor) {
-        return;
-    }
-
-    m_buttonTextColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_buttonTextColor, color, &ColorEditor::buttonTextColorChanged);
 }
 
 
@@ -194,12 +215,7 @@ QColor ColorEditor::buttonBackgroundColor() const
 
 void ColorEditor::setButtonBackgroundColor(const QColor &color)
 {
-    if (color == m_buttonBackgroundColor) {
-        return;
-    }
-
-    m_buttonBackgroundColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_buttonBackgroundColor, color, &ColorEditor::buttonBackgroundColorChanged);
 }
 
 
@@ -210,12 +226,7 @@ QColor ColorEditor::linkColor() const
 
 void ColorEditor::setLinkColor(const QColor &color)
 {
-    if (color == m_linkColor) {
-        return;
-    }
-
-    m_linkColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_linkColor, color, &ColorEditor::linkColorChanged);
 }
 
 
@@ -226,12 +237,7 @@ QColor ColorEditor::visitedLinkColor() const
 
 void ColorEditor::setVisitedLinkColor(const QColor &color)
 {
-    if (color == m_visitedLinkColor) {
-        return;
-    }
-
-    m_visitedLinkColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_visitedLinkColor, color, &ColorEditor::visitedLinkColorChanged);
 }
 
 
@@ -242,12 +248,7 @@ QColor ColorEditor::buttonHoverColor() const
 
 void ColorEditor::setButtonHoverColor(const QColor &color)
 {
-    if (color == m_buttonHoverColor) {
-        return;
-    }
-
-    m_buttonHoverColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_buttonHoverColor, color, &ColorEditor::buttonHoverColorChanged);
 }
 
 
@@ -258,12 +259,7 @@ QColor ColorEditor::buttonFocusColor() const
 
 void ColorEditor::setButtonFocusColor(const QColor &color)
 {
-    if (color == m_buttonFocusColor) {
-        return;
-    }
-
-    m_buttonFocusColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_buttonFocusColor, color, &ColorEditor::buttonFocusColorChanged);
 }
 
 
@@ -274,12 +270,7 @@ QColor ColorEditor::viewTextColor() const
 
 void ColorEditor::setViewTextColor(const QColor &color)
 {
-    if (color == m_viewTextColor) {
-        return;
-    }
-
-    m_viewTextColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_viewTextColor, color, &ColorEditor::viewTextColorChanged);
 }
 
 
@@ -290,12 +281,7 @@ QColor ColorEditor::viewBackgroundColor() const
 
 void ColorEditor::setViewBackgroundColor(const QColor &color)
 {
-    if (color == m_viewBackgroundColor) {
-        return;
-    }
-
-    m_viewBackgroundColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_viewBackgroundColor, color, &ColorEditor::viewBackgroundColorChanged);
 }
 
 
@@ -306,12 +292,7 @@ QColor ColorEditor::viewHoverColor() const
 
 void ColorEditor::setViewHoverColor(const QColor &color)
 {
-    if (color == m_viewHoverColor) {
-        return;
-    }
-
-    m_viewHoverColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_viewHoverColor, color, &ColorEditor::viewHoverColorChanged);
 }
 
 
@@ -322,12 +303,7 @@ QColor ColorEditor::viewFocusColor() const
 
 void ColorEditor::setViewFocusColor(const QColor &color)
 {
-    if (color == m_viewFocusColor) {
-        return;
-    }
-
-    m_viewFocusColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_viewFocusColor, color, &ColorEditor::viewFocusColorChanged);
 }
 
 
@@ -338,12 +314,7 @@ QColor ColorEditor::complementaryTextColor() const
 
 void ColorEditor::setComplementaryTextColor(const QColor &color)
 {
-    if (color == m_complementaryTextColor) {
-        return;
-    }
-
-    m_complementaryTextColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_complementaryTextColor, color, &ColorEditor::complementaryTextColorChanged);
 }
 
 
@@ -354,12 +325,7 @@ QColor ColorEditor::complementaryBackgroundColor() const
 
 void ColorEditor::setComplementaryBackgroundColor(const QColor &color)
 {
-    if (color == m_complementaryBackgroundColor) {
-        return;
-    }
-
-    m_complementaryBackgroundColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_complementaryBackgroundColor, color, &ColorEditor::complementaryBackgroundColorChanged);
 }
 
 
@@ -370,12 +336,7 @@ QColor ColorEditor::complementaryHoverColor() const
 
 void ColorEditor::setComplementaryHoverColor(const QColor &color)
 {
-    if (color == m_complementaryHoverColor) {
-        return;
-    }
-
-    m_complementaryHoverColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_complementaryHoverColor, color, &ColorEditor::complementaryHoverColorChanged);
 }
 
 
@@ -386,12 +347,7 @@ QColor ColorEditor::complementaryFocusColor() const
 
 void ColorEditor::setComplementaryFocusColor(const QColor &color)
 {
-    if (color == m_complementaryHoverColor) {
-        return;
-    }
-
-    m_complementaryFocusColor = color;
-    emit colorsChanged();
+    setColor(&ColorEditor::m_complementaryFocusColor, color, &ColorEditor::complementaryFocusColorChanged);
 }
 
 
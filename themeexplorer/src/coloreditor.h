@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QColor>
+#include <QVector>
 
 
 class ColorEditor : public QObject
@@ -29,26 +30,28 @@ class ColorEditor : public QObject
     Q_OBJECT
     //Q_PROPERTY(QString theme READ theme WRITE setTheme NOTIFY themeChanged)
 
-    Q_PROPERTY(QColor textColor READ textColor WRITE setTextColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor highlightColor READ highlightColor WRITE setHighlightColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor backgroundColor READ backgroundColor WRITE setBackgroundColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor linkColor READ linkColor WRITE setLinkColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor visitedLinkColor READ visitedLinkColor WRITE setVisitedLinkColor NOTIFY colorsChanged)
-
-    Q_PROPERTY(QColor buttonTextColor READ buttonTextColor WRITE setButtonTextColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor buttonBackgroundColor READ buttonBackgroundColor WRITE setButtonBackgroundColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor buttonHoverColor READ buttonHoverColor WRITE setButtonHoverColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor buttonFocusColor READ buttonFocusColor WRITE setButtonFocusColor NOTIFY colorsChanged)
-
-    Q_PROPERTY(QColor viewTextColor READ viewTextColor WRITE setViewTextColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor viewBackgroundColor READ viewBackgroundColor WRITE setViewBackgroundColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor viewHoverColor READ viewHoverColor WRITE setViewHoverColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor viewFocusColor READ viewFocusColor WRITE setViewFocusColor NOTIFY colorsChanged)
-
-    Q_PROPERTY(QColor complementaryTextColor READ complementaryTextColor WRITE setComplementaryTextColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor complementaryBackgroundColor READ complementaryBackgroundColor WRITE setComplementaryBackgroundColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor complementaryHoverColor READ complementaryHoverColor WRITE setComplementaryHoverColor NOTIFY colorsChanged)
-    Q_PROPERTY(QColor complementaryFocusColor READ complementaryFocusColor WRITE setComplementaryFocusColor NOTIFY colorsChanged) 
+    Q_PROPERTY(QColor textColor READ textColor WRITE setTextColor NOTIFY textColorChanged)
+    Q_PROPERTY(QColor highlightColor READ highlightColor WRITE setHighlightColor NOTIFY highlightColorChanged)
+    Q_PROPERTY(QColor backgroundColor READ backgroundColor WRITE setBackgroundColor NOTIFY backgroundColorChanged)
+    Q_PROPERTY(QColor linkColor READ linkColor WRITE setLinkColor NOTIFY linkColorChanged)
+    Q_PROPERTY(QColor visitedLinkColor READ visitedLinkColor WRITE setVisitedLinkColor NOTIFY visitedLinkColorChanged)
+
+    Q_PROPERTY(QColor buttonTextColor READ buttonTextColor WRITE setButtonTextColor NOTIFY buttonTextColorChanged)
+    Q_PROPERTY(QColor buttonBackgroundColor READ buttonBackgroundColor WRITE setButtonBackgroundColor NOTIFY buttonBackgroundColorChanged)
+    Q_PROPERTY(QColor buttonHoverColor READ buttonHoverColor WRITE setButtonHoverColor NOTIFY buttonHoverColorChanged)
+    Q_PROPERTY(QColor buttonFocusColor READ buttonFocusColor WRITE setButtonFocusColor NOTIFY buttonFocusColorChanged)
+
+    Q_PROPERTY(QColor viewTextColor READ viewTextColor WRITE setViewTextColor NOTIFY viewTextColorChanged)
+    Q_PROPERTY(QColor viewBackgroundColor READ viewBackgroundColor WRITE setViewBackgroundColor NOTIFY viewBackgroundColorChanged)
+    Q_PROPERTY(QColor viewHoverColor READ viewHoverColor WRITE setViewHoverColor NOTIFY viewHoverColorChanged)
+    Q_PROPERTY(QColor viewFocusColor READ viewFocusColor WRITE setViewFocusColor NOTIFY viewFocusColorChanged)
+
+    Q_PROPERTY(QColor complementaryTextColor READ complementaryTextColor WRITE setComplementaryTextColor NOTIFY complementaryTextColorChanged)
+    Q_PROPERTY(QColor complementaryBackgroundColor READ complementaryBackgroundColor WRITE setComplementaryBackgroundColor NOTIFY complementaryBackgroundColorChanged)
+    Q_PROPERTY(QColor complementaryHoverColor READ complementaryHoverColor WRITE setComplementaryHoverColor NOTIFY complementaryHoverColorChanged)
+    Q_PROPERTY(QColor complementaryFocusColor READ complementaryFocusColor WRITE setComplementaryFocusColor NOTIFY complementaryFocusColorChanged) 
+
+    Q_PROPERTY(bool previewing READ isPreviewing NOTIFY previewingChanged)
 public:
 
     explicit ColorEditor(QObject *parent = nullptr);
@@ -110,15 +113,72 @@ public:
 
 
     void load();
+
+    bool isPreviewing() const;
+
+    /**
+     * Starts trying out colors: they can be changed for the delegates to
+     * show, without anything being written until save().
+     *
+     * The preview does not reach Plasma::Theme, which only reads its colors
+     * from the colors file: the delegates take the colors from here instead.
+     */
+    Q_INVOKABLE void startPreview();
+
+    /**
+     * Ends the preview, going back to the colors it started with.
+     */
+    Q_INVOKABLE void cancelPreview();
+
+    /**
+     * Writes all the colors to the colors file of the theme, in one go,
+     * ending a preview.
+     */
     Q_INVOKABLE void save();
 
 Q_SIGNALS:
+    void textColorChanged();
+    void highlightColorChanged();
+    void backgroundColorChanged();
+    void linkColorChanged();
+    void visitedLinkColorChanged();
+    void buttonTextColorChanged();
+    void buttonBackgroundColorChanged();
+    void buttonHoverColorChanged();
+    void buttonFocusColorChanged();
+    void viewTextColorChanged();
+    void viewBackgroundColorChanged();
+    void viewHoverColorChanged();
+    void viewFocusColorChanged();
+    void complementaryTextColorChanged();
+    void complementaryBackgroundColorChanged();
+    void complementaryHoverColorChanged();
+    void complementaryFocusColorChanged();
+
+    // emitted once after any number of colors changed
     void colorsChanged();
     void themeChanged();
+    void previewingChanged();
 
 private:
+    // where a color is stored in the colors file
+    struct ColorEntry {
+        const char *group;
+        const char *key;
+        QColor ColorEditor::*color;
+        void (ColorEditor::*changed)();
+    };
+    static const ColorEntry s_colorEntries[];
+
+    QString colorsFile() const;
+    void setColor(QColor ColorEditor::*member, const QColor &color, void (ColorEditor::*changed)());
+
     QString m_theme;
 
+    bool m_previewing;
+    // the colors from before the preview, in the order of s_colorEntries
+    QVector<QColor> m_previewStart;
+
     QColor m_textColor;
     QColor m_highlightColor;
     QColor m_backgroundColor;
@@ -0,0 +1,112 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <iostream>
+
+#include <QApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <klocalizedstring.h>
+#include <qcommandlineparser.h>
+#include <qcommandlineoption.h>
+
+#include <kpackage/package.h>
+#include <kpackage/packageloader.h>
+
+#include "thememodel.h"
+#include "themerenderer.h"
+
+int main(int argc, char **argv)
+{
+    // only pngs get written, nothing is ever shown
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+
+    app.setApplicationVersion(PROJECT_VERSION);
+
+    QCommandLineParser parser;
+    parser.addVersionOption();
+    parser.addHelpOption();
+    parser.setApplicationDescription(i18n("Renders all the elements of a Plasma theme and compares them with an earlier rendering"));
+
+    QCommandLineOption themeOption(QStringList() << "t" << "theme", i18n("The theme to render"), "theme", "default");
+    QCommandLineOption outputOption(QStringList() << "o" << "output", i18n("Directory to write the rendered images to"), "directory");
+    QCommandLineOption baselineOption(QStringList() << "b" << "baseline", i18n("Output directory of an earlier run to compare with"), "directory");
+    QCommandLineOption sizesOption(QStringList() << "sizes", i18n("Comma separated sizes to render at"), "sizes", "16,32,64");
+    QCommandLineOption scalesOption(QStringList() << "scales", i18n("Comma separated scale factors to render at"), "factors", "1,2");
+    QCommandLineOption toleranceOption(QStringList() << "tolerance", i18n("Largest difference of a color channel counted as equal"), "value", "0");
+    QCommandLineOption slowestOption(QStringList() << "slowest", i18n("Number of the slowest svgs to report"), "count", "20");
+
+    parser.addOption(themeOption);
+    parser.addOption(outputOption);
+    parser.addOption(baselineOption);
+    parser.addOption(sizesOption);
+    parser.addOption(scalesOption);
+    parser.addOption(toleranceOption);
+    parser.addOption(slowestOption);
+
+    parser.process(app);
+
+    ThemeRenderer::Parameters parameters;
+    parameters.outputDir = parser.value(outputOption);
+    if (parameters.outputDir.isEmpty()) {
+        std::cerr << i18n("No output directory given, use --output").toLocal8Bit().constData() << std::endl;
+        return 2;
+    }
+    parameters.baselineDir = parser.value(baselineOption);
+    parameters.tolerance = parser.value(toleranceOption).toInt();
+
+    foreach (const QString &size, parser.value(sizesOption).split(QLatin1Char(','), QString::SkipEmptyParts)) {
+        if (size.toInt() > 0) {
+            parameters.sizes << size.toInt();
+        }
+    }
+    foreach (const QString &scale, parser.value(scalesOption).split(QLatin1Char(','), QString::SkipEmptyParts)) {
+        if (scale.toDouble() > 0) {
+            parameters.scales << scale.toDouble();
+        }
+    }
+    if (parameters.sizes.isEmpty() || parameters.scales.isEmpty()) {
+        std::cerr << i18n("No valid sizes or scale factors given").toLocal8Bit().constData() << std::endl;
+        return 2;
+    }
+
+    // the same description of the theme elements the explorer shows
+    KPackage::Package package = KPackage::PackageLoader::self()->loadPackage(QStringLiteral("KPackage/GenericQML"));
+    package.setPath(QStringLiteral("org.kde.plasma.themeexplorer"));
+    if (!package.isValid()) {
+        std::cerr << i18n("The themeexplorer package is not installed").toLocal8Bit().constData() << std::endl;
+        return 2;
+    }
+
+    ThemeModel model(package);
+    model.setTheme(parser.value(themeOption));
+
+    ThemeRenderer renderer(parameters);
+    const QVector<ThemeRenderer::Result> results = renderer.render(&model);
+    const QJsonObject report = renderer.report(model.theme(), results, parser.value(slowestOption).toInt());
+
+    std::cout << QJsonDocument(report).toJson(QJsonDocument::Indented).constData();
+
+    return report.value(QStringLiteral("mismatches")).toArray().isEmpty() ? 0 : 1;
+}
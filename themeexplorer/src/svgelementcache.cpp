@@ -0,0 +1,113 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "svgelementcache.h"
+
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include <QXmlStreamReader>
+
+#include <KCompressionDevice>
+
+// what QRegExp("\\d\\d$") matched, without compiling a regexp for every id
+static bool endsWithTwoDigits(const QStringRef &id)
+{
+    const int length = id.length();
+    return length >= 2 && id.at(length - 1).isDigit() && id.at(length - 2).isDigit();
+}
+
+static void addElement(SvgElements &elements, const QStringRef &id)
+{
+    if (!endsWithTwoDigits(id) && id != QLatin1String("base") && !id.contains(QLatin1String("layer"))) {
+        elements.ids << id.toString();
+    }
+    if (id.endsWith(QLatin1String("-center")) && !id.contains(QLatin1String("hint-"))) {
+        //remove -center
+        elements.prefixes << id.left(id.length() - 7).toString();
+    }
+}
+
+SvgElementCache::SvgElementCache()
+{
+}
+
+SvgElementCache::~SvgElementCache()
+{
+}
+
+SvgElements SvgElementCache::elements(const QString &path)
+{
+    const QFileInfo info(path);
+    const QDateTime modified = info.lastModified();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.constFind(path);
+        if (it != m_entries.constEnd() && it->modified == modified && it->size == info.size()) {
+            return it->elements;
+        }
+    }
+
+    Entry entry;
+    entry.modified = modified;
+    entry.size = info.size();
+    entry.elements = parse(path);
+
+    QMutexLocker locker(&m_mutex);
+    m_entries.insert(path, entry);
+    return entry.elements;
+}
+
+void SvgElementCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+}
+
+SvgElements SvgElementCache::parse(const QString &path)
+{
+    KCompressionDevice file(path, KCompressionDevice::GZip);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return SvgElements();
+    }
+
+    return parse(&file);
+}
+
+SvgElements SvgElementCache::parse(QIODevice *device)
+{
+    SvgElements elements;
+    QXmlStreamReader reader(device);
+
+    // only the id attribute of the start elements matters, everything else
+    // is skipped without being copied; a broken file gives what was read of it
+    while (!reader.atEnd()) {
+        if (reader.readNext() != QXmlStreamReader::StartElement) {
+            continue;
+        }
+
+        const QStringRef id = reader.attributes().value(QLatin1String("id"));
+        if (!id.isEmpty()) {
+            addElement(elements, id);
+        }
+    }
+
+    return elements;
+}
@@ -0,0 +1,83 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SVGELEMENTCACHE_H
+#define SVGELEMENTCACHE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+class QIODevice;
+
+/**
+ * The element ids of a theme svg the explorer is interested in.
+ */
+struct SvgElements
+{
+    // ids of the elements, without the numbered and layer ones
+    QStringList ids;
+    // prefixes of the frames, taken from their -center element
+    QStringList prefixes;
+};
+
+/**
+ * Parses svg and svgz files for their element ids, and remembers the result
+ * for as long as the file is not modified.
+ *
+ * The cache can be used from several threads at once; files are parsed
+ * without holding the lock.
+ */
+class SvgElementCache
+{
+public:
+    SvgElementCache();
+    ~SvgElementCache();
+
+    /**
+     * @return the elements of the svg at @p path, parsing it only if it was
+     * never parsed before or changed since
+     */
+    SvgElements elements(const QString &path);
+
+    void clear();
+
+    /**
+     * Parses the svg or svgz at @p path, without looking at the cache.
+     */
+    static SvgElements parse(const QString &path);
+
+    /**
+     * Parses the uncompressed svg read from @p device.
+     */
+    static SvgElements parse(QIODevice *device);
+
+private:
+    struct Entry {
+        QDateTime modified;
+        qint64 size;
+        SvgElements elements;
+    };
+
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // SVGELEMENTCACHE_H
@@ -27,21 +27,22 @@
 
 #include "themelistmodel.h"
 
+#include "packagecatalogue.h"
+
 #include <QApplication>
 #include <QDir>
 #include <QFile>
 #include <QPainter>
 #include <QStandardPaths>
 
-#include <KDesktopFile>
-
 #include <Plasma/Theme>
 #include <qstandardpaths.h>
 
 #include <QDebug>
 
 ThemeListModel::ThemeListModel( QObject *parent )
-: QAbstractListModel( parent )
+: QAbstractListModel( parent ),
+  m_catalogue(new PackageCatalogue(QStringLiteral("plasma/desktoptheme"), this))
 {
     m_roleNames.insert(Qt::DisplayRole, "display");
     m_roleNames.insert(PackageNameRole, "packageNameRole");
@@ -49,6 +50,7 @@ ThemeListModel::ThemeListModel( QObject *parent )
     m_roleNames.insert(PackageAuthorRole, "packageAuthorRole");
     m_roleNames.insert(PackageVersionRole, "packageVersionRole");
 
+    connect(m_catalogue, SIGNAL(packagesChanged()), this, SLOT(updateThemes()));
     reload();
 }
 
@@ -65,56 +67,41 @@ QHash<int, QByteArray> ThemeListModel::roleNames() const
 void ThemeListModel::clearThemeList()
 {
     m_themes.clear();
+    m_rows.clear();
 }
 
 void ThemeListModel::reload()
+{
+    // only reads the metadata of the packages which changed since the last time
+    m_catalogue->scan();
+}
+
+void ThemeListModel::updateThemes()
 {
     beginResetModel();
     clearThemeList();
 
-    // get all desktop themes
-    QStringList themes;
-    const QStringList &packs = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, "plasma/desktoptheme", QStandardPaths::LocateDirectory);
-    foreach (const QString &ppath, packs) {
-        const QDir cd(ppath);
-        const QStringList &entries = cd.entryList(QDir::Dirs | QDir::Hidden);
-        foreach (const QString pack, entries) {
-            const QString _metadata = ppath+QLatin1Char('/')+pack+QStringLiteral("/metadata.desktop");
-            if ((pack != "." && pack != "..") &&
-                (QFile::exists(_metadata))) {
-                themes << _metadata;
-            }
-        }
+    // the themes are sorted by name, and of themes with the same name the
+    // last one found wins
+    QMap<QString, ThemeInfo> sorted;
+    foreach (const PackageCatalogue::Package &package, m_catalogue->packages()) {
+        ThemeInfo info;
+        info.name = package.name;
+        info.package = package.pluginName;
+        info.description = package.comment;
+        info.author = package.author;
+        info.version = package.version;
+        info.themeRoot = package.root;
+        sorted[info.name] = info;
     }
 
-    foreach (const QString &theme, themes) {
-        int themeSepIndex = theme.lastIndexOf('/', -1);
-        QString themeRoot = theme.left(themeSepIndex);
-        int themeNameSepIndex = themeRoot.lastIndexOf('/', -1);
-        QString packageName = themeRoot.right(themeRoot.length() - themeNameSepIndex - 1);
-
-        KDesktopFile df(theme);
-
-        if (df.noDisplay()) {
-            continue;
-        }
-
-        QString name = df.readName();
-        if (name.isEmpty()) {
-            name = packageName;
+    m_themes.reserve(sorted.count());
+    foreach (const ThemeInfo &info, sorted) {
+        // indexOf() returned the first row of a package
+        if (!m_rows.contains(info.package)) {
+            m_rows.insert(info.package, m_themes.count());
         }
-        const QString comment = df.readComment();
-        const QString author = df.desktopGroup().readEntry("X-KDE-PluginInfo-Author",QString());
-        const QString version = df.desktopGroup().readEntry("X-KDE-PluginInfo-Version",QString());
-
-
-        ThemeInfo info;
-        info.package = packageName;
-        info.description = comment;
-        info.author = author;
-        info.version = version;
-        info.themeRoot = themeRoot;
-        m_themes[name] = info;
+        m_themes << info;
     }
 
     endResetModel();
@@ -136,22 +123,19 @@ QVariant ThemeListModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
-    QMap<QString, ThemeInfo>::const_iterator it = m_themes.constBegin();
-    for (int i = 0; i < index.row(); ++i) {
-        ++it;
-    }
+    const ThemeInfo &info = m_themes.at(index.row());
 
     switch (role) {
         case Qt::DisplayRole:
-            return it.key();
+            return info.name;
         case PackageNameRole:
-            return (*it).package;
+            return info.package;
         case PackageDescriptionRole:
-            return (*it).description;
+            return info.description;
         case PackageAuthorRole:
-            return (*it).author;
+            return info.author;
         case PackageVersionRole:
-            return (*it).version;
+            return info.version;
         default:
             return QVariant();
     }
@@ -160,30 +144,24 @@ QVariant ThemeListModel::data(const QModelIndex &index, int role) const
 QVariantMap ThemeListModel::get(int row) const
 {
     QVariantMap item;
+    if (row < 0 || row >= m_themes.count()) {
+        return item;
+    }
 
-    QModelIndex idx = index(row, 0);
-
-    item["display"] = data(idx, Qt::DisplayRole);
-    item["packageNameRole"] = data(idx, PackageNameRole);
-    item["packageDescriptionRole"] = data(idx, PackageDescriptionRole);
-    item["packageAuthorRole"] = data(idx, PackageAuthorRole);
-    item["packageVersionRole"] = data(idx, PackageVersionRole);
+    const ThemeInfo &info = m_themes.at(row);
+    item["display"] = info.name;
+    item["packageNameRole"] = info.package;
+    item["packageDescriptionRole"] = info.description;
+    item["packageAuthorRole"] = info.author;
+    item["packageVersionRole"] = info.version;
 
     return item;
 }
 
 QModelIndex ThemeListModel::indexOf(const QString &name) const
 {
-    QMapIterator<QString, ThemeInfo> it(m_themes);
-    int i = -1;
-    while (it.hasNext()) {
-        ++i;
-        if (it.next().value().package == name) {
-            return index(i, 0);
-        }
-    }
-
-    return QModelIndex();
+    const int row = m_rows.value(name, -1);
+    return row < 0 ? QModelIndex() : index(row, 0);
 }
 
 #include "moc_themelistmodel.cpp"
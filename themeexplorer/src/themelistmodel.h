@@ -29,16 +29,21 @@
 #define THEMELISTMODEL_H
 
 #include <QAbstractItemView>
+#include <QHash>
+#include <QVector>
 
 namespace Plasma
 {
     class FrameSvg;
 }
 
+class PackageCatalogue;
+
 //Theme selector code by Andre Duffeck (modified to add package description)
 class ThemeInfo
 {
 public:
+    QString name;
     QString package;
     QString description;
     QString author;
@@ -77,10 +82,16 @@ public:
 Q_SIGNALS:
     void countChanged();
 
+private Q_SLOTS:
+    void updateThemes();
+
 private:
     QHash<int, QByteArray> m_roleNames;
+    PackageCatalogue *m_catalogue;
 
-    QMap<QString, ThemeInfo> m_themes;
+    // sorted by name; m_rows maps the package names to their row
+    QVector<ThemeInfo> m_themes;
+    QHash<QString, int> m_rows;
 };
 
 
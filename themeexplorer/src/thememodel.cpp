@@ -22,65 +22,37 @@
 #include "coloreditor.h"
 #include <QDebug>
 #include <QByteArray>
+#include <QDBusConnection>
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
 #include <QIcon>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QStandardPaths>
+#include <QtConcurrentMap>
 
-#include <QXmlSimpleReader>
-#include <QXmlDefaultHandler>
-#include <QXmlInputSource>
+#include <functional>
 
-#include <KCompressionDevice>
+#include <KDirNotify>
 #include <KProcess>
 #include <KIO/Job>
 #include <KRun>
 
 #include <Plasma/Theme>
 
-class IconsParserHandler : public QXmlDefaultHandler
-{
-public:
-    IconsParserHandler();
-    bool startElement(const QString &namespaceURI, const QString &localName,
-                      const QString &qName, const QXmlAttributes &atts) override;
-    QStringList m_ids;
-    QStringList m_prefixes;
-};
-
-IconsParserHandler::IconsParserHandler()
-    : QXmlDefaultHandler()
-{}
-
-bool IconsParserHandler::startElement(const QString &namespaceURI, const QString &localName,
-                      const QString &qName, const QXmlAttributes &atts)
-{
-    Q_UNUSED(namespaceURI)
-    Q_UNUSED(localName)
-    Q_UNUSED(qName)
-
-    const QString id = atts.value("id");
-    //qWarning() << "Start Element:"<<id;
-
-    if (!id.isEmpty() && !id.contains(QRegExp("\\d\\d$")) &&
-        id != "base" && !id.contains("layer")) {
-        m_ids<<id;
-    }
-    if (id.endsWith("-center") && !id.contains("hint-")) {
-        //remove -center
-        m_prefixes << id.mid(0, id.length() - 7);
-    }
-    return true;
-}
-
 ThemeModel::ThemeModel(const KPackage::Package &package, QObject *parent)
     : QAbstractListModel(parent),
       m_theme(new Plasma::Theme),
       m_themeName(QStringLiteral("default")),
       m_package(package),
+      m_writable(false),
       m_themeListModel(new ThemeListModel(this)),
-      m_colorEditor(new ColorEditor(this))      
+      m_colorEditor(new ColorEditor(this)),
+      m_svgElements(new SvgElementCache),
+      m_pendingEdits(0),
+      m_editProgress(0)
 {
     m_theme->setUseGlobalSettings(false);
     m_theme->setThemeName(m_themeName);
@@ -93,12 +65,26 @@ ThemeModel::ThemeModel(const KPackage::Package &package, QObject *parent)
     m_roleNames.insert(IsWritable, "isWritable");
     m_roleNames.insert(IconElements, "iconElements");
     m_roleNames.insert(FrameSvgPrefixes, "frameSvgPrefixes");
+    m_roleNames.insert(FileSize, "fileSize");
+    m_roleNames.insert(Revision, "revision");
+
+    connect(&m_editWatcher, SIGNAL(fileChanged(QString)), this, SLOT(elementFileChanged(QString)));
+
+    // editors write a file several times while saving it
+    m_notifyTimer.setSingleShot(true);
+    m_notifyTimer.setInterval(200);
+    connect(&m_notifyTimer, SIGNAL(timeout()), this, SLOT(notifyChangedFiles()));
+
+    // svgs changed by other processes, e.g. another explorer
+    OrgKdeKDirNotifyInterface *dirNotify = new OrgKdeKDirNotifyInterface(QString(), QString(), QDBusConnection::sessionBus(), this);
+    connect(dirNotify, SIGNAL(FilesChanged(QStringList)), this, SLOT(filesChanged(QStringList)));
 
     load();
 }
 
 ThemeModel::~ThemeModel()
 {
+    stopPrefetch();
 }
 
 ThemeListModel *ThemeModel::themeList()
@@ -119,66 +105,114 @@ QHash<int, QByteArray> ThemeModel::roleNames() const
 int ThemeModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
-    return m_jsonDoc.array().size();
+    return m_elements.count();
 }
 
 QVariant ThemeModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() < 0 || index.row() > m_jsonDoc.array().size()) {
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_elements.count()) {
         return QVariant();
     }
 
-    const QVariantMap value = m_jsonDoc.array().at(index.row()).toObject().toVariantMap();
+    const ThemeElement &element = m_elements.at(index.row());
 
     switch (role) {
     case ImagePath:
-        return value.value("imagePath");
+        return element.imagePath;
     case Description:
-        return value.value("description");
+        return element.description;
     case Delegate:
-        return value.value("delegate");
+        return element.delegate;
     case UsesFallback:
-        return !m_theme->currentThemeHasImage(value.value("imagePath").toString());
-    case SvgAbsolutePath: {
-        QString path = m_theme->imagePath(value.value("imagePath").toString());
-        if (!value.value("imagePath").toString().contains("translucent")) {
-             path = path.replace("translucent/", "");
-        }
-        return path;
-    }
+        return !m_overrides.testBit(index.row());
+    case SvgAbsolutePath:
+        return element.svgPath;
     case IsWritable:
-        return QFile::exists(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/plasma/desktoptheme/" + m_themeName);
+        return m_writable;
     case IconElements:
+        return m_svgElements->elements(element.svgPath).ids;
     case FrameSvgPrefixes:
-    {
-        QString path = m_theme->imagePath(value.value("imagePath").toString());
-        if (!value.value("imagePath").toString().contains("translucent")) {
-             path = path.replace("translucent/", "");
-        }
-        KCompressionDevice file(path, KCompressionDevice::GZip);
-        if (!file.open(QIODevice::ReadOnly)) {
-            return QVariant();
-        }
+        return m_svgElements->elements(element.svgPath).prefixes;
+    case FileSize:
+        return m_fileSizes.at(index.row());
+    case Revision:
+        return element.revision;
+    }
 
-        QXmlSimpleReader reader;
-        IconsParserHandler handler;
-        reader.setContentHandler(&handler);
-        QXmlInputSource source(&file);
-        reader.parse(&source);
+    return QVariant();
+}
 
-        if (role == IconElements) {
-            return handler.m_ids;
-        } else {
-            return handler.m_prefixes;
-        }
+void ThemeModel::analyze()
+{
+    m_overrides.fill(false, m_elements.count());
+    m_fileSizes.fill(0, m_elements.count());
+    for (int row = 0; row < m_elements.count(); ++row) {
+        analyzeElement(row);
     }
+
+    m_writable = QFile::exists(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/plasma/desktoptheme/" + m_themeName);
+}
+
+void ThemeModel::analyzeElement(int row)
+{
+    ThemeElement &element = m_elements[row];
+    element.svgPath = svgPath(element.imagePath);
+    m_overrides.setBit(row, m_theme->currentThemeHasImage(element.imagePath));
+    m_fileSizes[row] = QFileInfo(element.svgPath).size();
+}
+
+void ThemeModel::reanalyze(const QString &imagePath)
+{
+    for (int row = 0; row < m_elements.count(); ++row) {
+        if (m_elements.at(row).imagePath == imagePath) {
+            analyzeElement(row);
+            ++m_elements[row].revision;
+            emit dataChanged(index(row, 0), index(row, 0));
+        }
     }
 
-    return QVariant();
+    emit coverageChanged();
+}
+
+QString ThemeModel::svgPath(const QString &imagePath) const
+{
+    QString path = m_theme->imagePath(imagePath);
+    if (!imagePath.contains("translucent")) {
+         path = path.replace("translucent/", "");
+    }
+    return path;
 }
 
+void ThemeModel::prefetch()
+{
+    stopPrefetch();
+
+    // Plasma::Theme is not thread safe, so analyze() resolved the paths on
+    // this thread already; that is cheap next to parsing the files
+    QStringList paths;
+    for (int row = 0; row < m_elements.count(); ++row) {
+        const QString path = m_elements.at(row).svgPath;
+        if (!path.isEmpty() && !paths.contains(path)) {
+            paths << path;
+        }
+    }
 
+    // mapped() keeps its own copy of the paths and the job holds on to the
+    // cache, so nothing has to wait for it; a file it parses after being
+    // cancelled is still checked against its mtime and size when looked up
+    QSharedPointer<SvgElementCache> cache = m_svgElements;
+    std::function<bool(const QString &)> parse = [cache](const QString &path) {
+        cache->elements(path);
+        return true;
+    };
+    m_prefetch = QtConcurrent::mapped(paths, parse);
+}
 
+void ThemeModel::stopPrefetch()
+{
+    // a file already being parsed is finished in the background
+    m_prefetch.cancel();
+}
 
 void ThemeModel::load()
 {
@@ -189,13 +223,28 @@ void ThemeModel::load()
     jsonFile.open(QIODevice::ReadOnly);
 
     QJsonParseError error;
-    m_jsonDoc = QJsonDocument::fromJson(jsonFile.readAll(), &error);
+    const QJsonDocument doc = QJsonDocument::fromJson(jsonFile.readAll(), &error);
 
     if (error.error != QJsonParseError::NoError) {
         qWarning() << "Error parsing Json" << error.errorString();
     }
 
+    const QJsonArray array = doc.array();
+    m_elements.clear();
+    m_elements.reserve(array.size());
+    foreach (const QJsonValue &value, array) {
+        const QJsonObject object = value.toObject();
+        ThemeElement element;
+        element.imagePath = object.value(QStringLiteral("imagePath")).toString();
+        element.description = object.value(QStringLiteral("description")).toString();
+        element.delegate = object.value(QStringLiteral("delegate")).toString();
+        m_elements << element;
+    }
+
+    analyze();
+    prefetch();
     endResetModel();
+    emit coverageChanged();
 }
 
 QString ThemeModel::theme() const
@@ -223,6 +272,27 @@ QString ThemeModel::website() const
     return m_theme->pluginInfo().website();
 }
 
+int ThemeModel::elementCount() const
+{
+    return m_elements.count();
+}
+
+int ThemeModel::overriddenCount() const
+{
+    return m_overrides.count(true);
+}
+
+qint64 ThemeModel::overriddenSize() const
+{
+    qint64 size = 0;
+    for (int row = 0; row < m_fileSizes.count(); ++row) {
+        if (m_overrides.testBit(row)) {
+            size += m_fileSizes.at(row);
+        }
+    }
+    return size;
+}
+
 void ThemeModel::setTheme(const QString& theme)
 {
     if (theme == m_themeName) {
@@ -231,6 +301,8 @@ void ThemeModel::setTheme(const QString& theme)
 
     m_themeName = theme;
     m_theme->setThemeName(theme);
+    stopPrefetch();
+    m_svgElements->clear();
     load();
     m_colorEditor->setTheme(theme);
     emit themeChanged();
@@ -238,53 +310,154 @@ void ThemeModel::setTheme(const QString& theme)
 
 void ThemeModel::editElement(const QString& imagePath)
 {
-    QString file = m_theme->imagePath(imagePath);
-    if (!file.contains("translucent")) {
-            file = file.replace("translucent/", "");
-    }
-
-    QString finalFile;
+    const QString file = svgPath(imagePath);
 
     if (m_theme->currentThemeHasImage(imagePath)) {
-        finalFile = file;
-    } else {
-        finalFile = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/plasma/desktoptheme/" + m_themeName + "/" + imagePath + ".svgz";
-        const QString dirPath = QFileInfo(finalFile).absoluteDir().absolutePath();
-        KIO::mkdir(QUrl::fromLocalFile(dirPath))->exec();
-
-        KIO::FileCopyJob *job = KIO::file_copy( QUrl::fromLocalFile(file), QUrl::fromLocalFile(finalFile) );
-        if (!job->exec()) {
-            qWarning() << "Error copying" << file << "to" << finalFile;
+        openInEditor(imagePath, file);
+        return;
+    }
+
+    // the theme doesn't have this image yet: the editor gets a copy of the
+    // fallback, put into the theme; none of the jobs block the event loop
+    const QString finalFile = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/plasma/desktoptheme/" + m_themeName + "/" + imagePath + ".svgz";
+    const QString dirPath = QFileInfo(finalFile).absoluteDir().absolutePath();
+
+    ++m_pendingEdits;
+    setEditProgress(0);
+
+    KIO::SimpleJob *mkdirJob = KIO::mkdir(QUrl::fromLocalFile(dirPath));
+    connect(mkdirJob, &KJob::result, this, [this, imagePath, file, finalFile](KJob *job) {
+        if (job->error() && job->error() != KIO::ERR_DIR_ALREADY_EXIST) {
+            qWarning() << "Error creating the folder of" << finalFile << job->errorString();
+            --m_pendingEdits;
+            emit editProgressChanged();
+            return;
         }
+
+        setEditProgress(10);
+        KIO::FileCopyJob *copyJob = KIO::file_copy(QUrl::fromLocalFile(file), QUrl::fromLocalFile(finalFile), -1, KIO::HideProgressInfo);
+        connect(copyJob, &KJob::percent, this, [this](KJob *, unsigned long percent) {
+            setEditProgress(10 + int(percent) * 9 / 10);
+        });
+        connect(copyJob, &KJob::result, this, [this, imagePath, file, finalFile](KJob *job) {
+            --m_pendingEdits;
+            if (job->error()) {
+                qWarning() << "Error copying" << file << "to" << finalFile << job->errorString();
+                emit editProgressChanged();
+                return;
+            }
+
+            setEditProgress(100);
+            reanalyze(imagePath);
+            openInEditor(imagePath, finalFile);
+        });
+    });
+}
+
+void ThemeModel::openInEditor(const QString &imagePath, const QString &file)
+{
+    m_editedFiles.insert(file, imagePath);
+    if (!m_editWatcher.files().contains(file)) {
+        m_editWatcher.addPath(file);
     }
 
-    //QProcess::startDetached("inkscape", QStringList() << finalFile);
+    //QProcess::startDetached("inkscape", QStringList() << file);
     KProcess *process = new KProcess();
     //TODO: don't use the script to not depend from bash/linux?
-    process->setProgram("bash", QStringList() << m_package.filePath("scripts", "openInEditor.sh") << finalFile);
-
-    connect(process, SIGNAL(finished(int,QProcess::ExitStatus)), this, SLOT(processFinished()));
+    process->setProgram("bash", QStringList() << m_package.filePath("scripts", "openInEditor.sh") << file);
+
+    connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this, [this, process, file]() {
+        elementFileChanged(file);
+        m_editWatcher.removePath(file);
+        m_editedFiles.remove(file);
+        process->deleteLater();
+    });
     process->start();
 }
 
-void ThemeModel::processFinished()
+void ThemeModel::elementFileChanged(const QString &path)
 {
-    /*We increment the microversion of the theme: keeps track and will force the cache to be
-      discarded in order to reload immediately the graphics*/
-    const QString metadataPath(QStandardPaths::locate(QStandardPaths::GenericDataLocation, QLatin1Literal("plasma/desktoptheme/") % m_themeName % QLatin1Literal("/metadata.desktop")));
-    KConfig c(metadataPath);
-    KConfigGroup cg(&c, "Desktop Entry");
+    const QString imagePath = m_editedFiles.value(path);
+    if (imagePath.isEmpty()) {
+        return;
+    }
 
-    QStringList version = cg.readEntry("X-KDE-PluginInfo-Version", "0.0").split('.');
-    if (version.length() < 2) {
-        version << QLatin1Literal("0");
+    // editors tend to save by replacing the file, which ends the watch
+    if (QFile::exists(path) && !m_editWatcher.files().contains(path)) {
+        m_editWatcher.addPath(path);
     }
-    if (version.length() < 3) {
-        version << QLatin1Literal("0");
+
+    // only the edited svg is dropped from the caches and reloaded by its
+    // delegates, rather than bumping the theme version, which would make
+    // Plasma discard the pixmaps of every svg of the theme
+    m_theme->invalidateRectsCache(path);
+    reanalyze(imagePath);
+
+    m_handledChanges.insert(path, QFileInfo(path).lastModified());
+    m_changedFiles.insert(path);
+    m_notifyTimer.start();
+}
+
+void ThemeModel::notifyChangedFiles()
+{
+    // the per-file change notification of KIO, so running Plasma processes
+    // can evict exactly these svgs from their caches
+    QList<QUrl> urls;
+    foreach (const QString &path, m_changedFiles) {
+        urls << QUrl::fromLocalFile(path);
     }
+    m_changedFiles.clear();
 
-    cg.writeEntry("X-KDE-PluginInfo-Version", QString(version.first() + QLatin1Literal(".") + version[1] + QLatin1Literal(".") + QString::number(version.last().toInt() + 1)));
-    cg.sync();
+    if (!urls.isEmpty()) {
+        org::kde::KDirNotify::emitFilesChanged(urls);
+    }
+}
+
+void ThemeModel::filesChanged(const QStringList &urls)
+{
+    foreach (const QString &url, urls) {
+        const QString path = QUrl(url).toLocalFile();
+
+        // changes made through this model, including the ones it announced
+        // itself, were handled already
+        if (path.isEmpty() || m_editedFiles.contains(path)) {
+            continue;
+        }
+        const QDateTime modified = QFileInfo(path).lastModified();
+        if (m_handledChanges.value(path) == modified) {
+            continue;
+        }
+
+        QString imagePath;
+        foreach (const ThemeElement &element, m_elements) {
+            if (element.svgPath == path) {
+                imagePath = element.imagePath;
+                break;
+            }
+        }
+
+        if (!imagePath.isEmpty()) {
+            m_handledChanges.insert(path, modified);
+            m_theme->invalidateRectsCache(path);
+            reanalyze(imagePath);
+        }
+    }
+}
+
+bool ThemeModel::isPreparingEdit() const
+{
+    return m_pendingEdits > 0;
+}
+
+int ThemeModel::editProgress() const
+{
+    return m_editProgress;
+}
+
+void ThemeModel::setEditProgress(int progress)
+{
+    m_editProgress = progress;
+    emit editProgressChanged();
 }
 
 void ThemeModel::editThemeMetaData(const QString& name, const QString& author, const QString& email, const QString &license, const QString& website)
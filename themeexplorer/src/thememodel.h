@@ -21,11 +21,19 @@
 #define THEMEMODEL_H
 
 #include <QAbstractListModel>
-#include <QJsonArray>
-#include <QJsonObject>
-#include <QJsonDocument>
+#include <QBitArray>
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QFuture>
+#include <QSet>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QStringList>
+#include <QVector>
 #include <kpackage/package.h>
 
+#include "svgelementcache.h"
+
 namespace Plasma {
     class Theme;
 }
@@ -47,6 +55,13 @@ class ThemeModel : public QAbstractListModel
     Q_PROPERTY(QString website READ website NOTIFY themeChanged)
 
     Q_PROPERTY(QString themeFolder READ themeFolder NOTIFY themeChanged)
+
+    Q_PROPERTY(int elementCount READ elementCount NOTIFY coverageChanged)
+    Q_PROPERTY(int overriddenCount READ overriddenCount NOTIFY coverageChanged)
+    Q_PROPERTY(qint64 overriddenSize READ overriddenSize NOTIFY coverageChanged)
+
+    Q_PROPERTY(bool preparingEdit READ isPreparingEdit NOTIFY editProgressChanged)
+    Q_PROPERTY(int editProgress READ editProgress NOTIFY editProgressChanged)
 public:
     enum Roles {
         ImagePath,
@@ -56,7 +71,9 @@ public:
         SvgAbsolutePath,
         IsWritable,
         IconElements,
-        FrameSvgPrefixes
+        FrameSvgPrefixes,
+        FileSize,
+        Revision
     };
 
     explicit ThemeModel(const KPackage::Package &package, QObject *parent = nullptr);
@@ -77,6 +94,13 @@ public:
     QString license() const;
     QString website() const;
 
+    int elementCount() const;
+    int overriddenCount() const;
+    qint64 overriddenSize() const;
+
+    bool isPreparingEdit() const;
+    int editProgress() const;
+
     void load();
 
     Q_INVOKABLE void editElement(const QString& imagePath);
@@ -87,19 +111,64 @@ public:
 
 Q_SIGNALS:
     void themeChanged();
+    void coverageChanged();
+    void editProgressChanged();
 
 private Q_SLOTS:
-    void processFinished();
+    void elementFileChanged(const QString &path);
+    void notifyChangedFiles();
+    void filesChanged(const QStringList &urls);
 
 private:
+    // one entry of themeDescription.json
+    struct ThemeElement {
+        QString imagePath;
+        QString description;
+        QString delegate;
+        QString svgPath;
+        // bumped whenever the svg changed, so the delegates load it again
+        int revision = 0;
+    };
+
+    QString svgPath(const QString &imagePath) const;
+    void analyze();
+    void analyzeElement(int row);
+    void reanalyze(const QString &imagePath);
+    void openInEditor(const QString &imagePath, const QString &file);
+    void setEditProgress(int progress);
+    void prefetch();
+    void stopPrefetch();
+
     QHash<int, QByteArray> m_roleNames;
 
     Plasma::Theme *m_theme;
     QString m_themeName;
     KPackage::Package m_package;
-    QJsonDocument m_jsonDoc;
+    QVector<ThemeElement> m_elements;
+    // what the current theme provides, worked out by analyze() so data()
+    // never has to touch the disk for it
+    QBitArray m_overrides;
+    QVector<qint64> m_fileSizes;
+    bool m_writable;
     ThemeListModel *m_themeListModel;
     ColorEditor *m_colorEditor;
+    // parsing the svgz files is by far the slowest part of data()
+    // shared with the prefetch job, which may outlive a theme or the model
+    QSharedPointer<SvgElementCache> m_svgElements;
+    // parses the svgs of the current theme ahead of the delegates asking
+    QFuture<bool> m_prefetch;
+
+    // copies of fallback svgs being made for editing
+    int m_pendingEdits;
+    int m_editProgress;
+    // the files open in an editor, and the element each of them belongs to
+    QHash<QString, QString> m_editedFiles;
+    QFileSystemWatcher m_editWatcher;
+    // edited files not announced to other processes yet
+    QSet<QString> m_changedFiles;
+    // the version of each changed svg the model is up to date with
+    QHash<QString, QDateTime> m_handledChanges;
+    QTimer m_notifyTimer;
 };
 
 #endif // THEMEMODEL_H
@@ -0,0 +1,331 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "themerenderer.h"
+#include "thememodel.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonArray>
+#include <QPainter>
+#include <QSet>
+#include <QSvgRenderer>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <functional>
+
+static const int s_reportVersion = 1;
+
+static QString imageName(const QString &imagePath, const QString &name, int size, qreal scale)
+{
+    return imagePath % QLatin1Char('/') % name % QLatin1Char('-') % QString::number(size)
+           % QLatin1Char('@') % QString::number(scale) % QLatin1String("x.png");
+}
+
+static QImage createImage(const QSize &size, qreal scale)
+{
+    QImage image(size * scale, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(scale);
+    image.fill(Qt::transparent);
+    return image;
+}
+
+ThemeRenderer::ThemeRenderer(const Parameters &parameters)
+    : m_parameters(parameters)
+{
+}
+
+ThemeRenderer::~ThemeRenderer()
+{
+}
+
+QVector<ThemeRenderer::Result> ThemeRenderer::render(const ThemeModel *model) const
+{
+    // the model resolves the paths through Plasma::Theme, which has to
+    // stay in this thread; only the rendering happens in parallel
+    QVector<Job> jobs;
+    QSet<QString> svgPaths;
+    for (int row = 0; row < model->rowCount(QModelIndex()); ++row) {
+        const QModelIndex index = model->index(row, 0);
+        Job job;
+        job.svgPath = index.data(ThemeModel::SvgAbsolutePath).toString();
+        if (job.svgPath.isEmpty() || svgPaths.contains(job.svgPath)) {
+            continue;
+        }
+        svgPaths.insert(job.svgPath);
+
+        job.imagePath = index.data(ThemeModel::ImagePath).toString();
+        job.ids = index.data(ThemeModel::IconElements).toStringList();
+        job.prefixes = index.data(ThemeModel::FrameSvgPrefixes).toStringList();
+        // the frame without a prefix, e.g. in widgets/background, has a
+        // plain center element instead of a -center one
+        if (job.ids.contains(QStringLiteral("center"))) {
+            job.prefixes.prepend(QString());
+        }
+        jobs << job;
+    }
+
+    std::function<Result(const Job &)> renderFunction = [this](const Job &job) {
+        return renderJob(job);
+    };
+    return QtConcurrent::blockingMapped<QVector<Result> >(jobs, renderFunction);
+}
+
+ThemeRenderer::Result ThemeRenderer::renderJob(const Job &job) const
+{
+    Result result;
+    result.imagePath = job.imagePath;
+    result.svgPath = job.svgPath;
+
+    QElapsedTimer timer;
+    timer.start();
+    QSvgRenderer renderer;
+    result.valid = renderer.load(job.svgPath);
+    result.loadTime = timer.nsecsElapsed();
+    if (!result.valid) {
+        return result;
+    }
+
+    QDir().mkpath(m_parameters.outputDir % QLatin1Char('/') % job.imagePath);
+
+    // the hints only tell Plasma how to draw the other elements
+    QStringList names;
+    QVector<bool> frames;
+    foreach (const QString &id, job.ids) {
+        if (!id.startsWith(QLatin1String("hint-"))) {
+            names << id;
+            frames << false;
+        }
+    }
+    foreach (const QString &prefix, job.prefixes) {
+        names << prefix;
+        frames << true;
+    }
+
+    for (int i = 0; i < names.count(); ++i) {
+        foreach (int size, m_parameters.sizes) {
+            foreach (qreal scale, m_parameters.scales) {
+                QImage image;
+                timer.restart();
+                if (frames.at(i)) {
+                    renderFrame(renderer, names.at(i), size, scale, image);
+                } else {
+                    renderElement(renderer, names.at(i), size, scale, image);
+                }
+                result.renderTime += timer.nsecsElapsed();
+
+                if (image.isNull()) {
+                    continue;
+                }
+
+                QString name = names.at(i);
+                if (frames.at(i)) {
+                    name = name.isEmpty() ? QStringLiteral("frame") : QString(name % QLatin1String("-frame"));
+                }
+                const QString fileName = imageName(job.imagePath, name, size, scale);
+                image.save(m_parameters.outputDir % QLatin1Char('/') % fileName);
+                ++result.imageCount;
+
+                if (!m_parameters.baselineDir.isEmpty()) {
+                    compare(image, fileName, result);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+void ThemeRenderer::renderElement(QSvgRenderer &renderer, const QString &id, int size, qreal scale, QImage &image) const
+{
+    const QRectF bounds = renderer.boundsOnElement(id);
+    if (bounds.isEmpty()) {
+        return;
+    }
+
+    // the longer side gets the requested size, as for an icon
+    const QSizeF fitted = bounds.size().scaled(size, size, Qt::KeepAspectRatio);
+    image = createImage(fitted.toSize().expandedTo(QSize(1, 1)), scale);
+
+    QPainter painter(&image);
+    renderer.render(&painter, id, QRectF(QPointF(0, 0), fitted));
+}
+
+void ThemeRenderer::renderFrame(QSvgRenderer &renderer, const QString &prefix, int size, qreal scale, QImage &image) const
+{
+    const QString base = prefix.isEmpty() ? QString() : QString(prefix % QLatin1Char('-'));
+    auto partBounds = [&renderer, &base](const char *part) {
+        const QString id = base % QLatin1String(part);
+        return renderer.elementExists(id) ? renderer.boundsOnElement(id).size() : QSizeF();
+    };
+
+    // laid out the way FrameSvg does: corners at their own size, edges
+    // stretched along the frame and the center filling the rest
+    qreal left = partBounds("left").width();
+    qreal right = partBounds("right").width();
+    qreal top = partBounds("top").height();
+    qreal bottom = partBounds("bottom").height();
+
+    // a frame smaller than its borders gets them shrunk proportionally
+    if (left + right > size) {
+        const qreal factor = size / (left + right);
+        left *= factor;
+        right *= factor;
+    }
+    if (top + bottom > size) {
+        const qreal factor = size / (top + bottom);
+        top *= factor;
+        bottom *= factor;
+    }
+
+    const qreal centerWidth = size - left - right;
+    const qreal centerHeight = size - top - bottom;
+
+    image = createImage(QSize(size, size), scale);
+    QPainter painter(&image);
+
+    auto renderPart = [&renderer, &painter, &base](const char *part, const QRectF &rect) {
+        const QString id = base % QLatin1String(part);
+        if (!rect.isEmpty() && renderer.elementExists(id)) {
+            renderer.render(&painter, id, rect);
+        }
+    };
+
+    renderPart("topleft", QRectF(0, 0, left, top));
+    renderPart("top", QRectF(left, 0, centerWidth, top));
+    renderPart("topright", QRectF(left + centerWidth, 0, right, top));
+    renderPart("left", QRectF(0, top, left, centerHeight));
+    renderPart("center", QRectF(left, top, centerWidth, centerHeight));
+    renderPart("right", QRectF(left + centerWidth, top, right, centerHeight));
+    renderPart("bottomleft", QRectF(0, top + centerHeight, left, bottom));
+    renderPart("bottom", QRectF(left, top + centerHeight, centerWidth, bottom));
+    renderPart("bottomright", QRectF(left + centerWidth, top + centerHeight, right, bottom));
+}
+
+bool ThemeRenderer::compare(const QImage &image, const QString &fileName, Result &result) const
+{
+    const QString baselinePath = m_parameters.baselineDir % QLatin1Char('/') % fileName;
+    if (!QFileInfo::exists(baselinePath)) {
+        result.missing << fileName;
+        return true;
+    }
+
+    const QImage rendered = image.convertToFormat(QImage::Format_ARGB32);
+    const QImage baseline = QImage(baselinePath).convertToFormat(QImage::Format_ARGB32);
+
+    // differing pixels in red over a faded copy of the baseline
+    QImage diff(rendered.size(), QImage::Format_ARGB32);
+    diff.fill(Qt::transparent);
+    bool equal = rendered.size() == baseline.size();
+
+    if (equal) {
+        const int tolerance = m_parameters.tolerance;
+        for (int y = 0; y < rendered.height(); ++y) {
+            const QRgb *renderedLine = reinterpret_cast<const QRgb *>(rendered.constScanLine(y));
+            const QRgb *baselineLine = reinterpret_cast<const QRgb *>(baseline.constScanLine(y));
+            QRgb *diffLine = reinterpret_cast<QRgb *>(diff.scanLine(y));
+            for (int x = 0; x < rendered.width(); ++x) {
+                const QRgb a = renderedLine[x];
+                const QRgb b = baselineLine[x];
+                if (qAbs(qRed(a) - qRed(b)) > tolerance || qAbs(qGreen(a) - qGreen(b)) > tolerance
+                    || qAbs(qBlue(a) - qBlue(b)) > tolerance || qAbs(qAlpha(a) - qAlpha(b)) > tolerance) {
+                    diffLine[x] = qRgba(255, 0, 0, 255);
+                    equal = false;
+                } else {
+                    const int gray = qGray(b);
+                    diffLine[x] = qRgba(gray, gray, gray, qAlpha(b) / 4);
+                }
+            }
+        }
+    } else {
+        // nothing to line up, the new rendering is the most useful to see
+        diff = rendered;
+    }
+
+    if (!equal) {
+        result.mismatches << fileName;
+        QString diffName = m_parameters.outputDir % QLatin1Char('/') % fileName;
+        diffName.replace(diffName.length() - 4, 4, QStringLiteral(".diff.png"));
+        diff.save(diffName);
+    }
+
+    return equal;
+}
+
+QJsonObject ThemeRenderer::report(const QString &theme, const QVector<Result> &results, int slowest) const
+{
+    QJsonArray sizes;
+    foreach (int size, m_parameters.sizes) {
+        sizes.append(size);
+    }
+    QJsonArray scales;
+    foreach (qreal scale, m_parameters.scales) {
+        scales.append(scale);
+    }
+
+    int images = 0;
+    int missing = 0;
+    QJsonArray failures;
+    QJsonArray mismatches;
+    foreach (const Result &result, results) {
+        images += result.imageCount;
+        missing += result.missing.count();
+        if (!result.valid) {
+            failures.append(result.svgPath);
+        }
+        foreach (const QString &fileName, result.mismatches) {
+            mismatches.append(fileName);
+        }
+    }
+
+    QVector<Result> sorted = results;
+    std::sort(sorted.begin(), sorted.end(), [](const Result &a, const Result &b) {
+        return a.loadTime + a.renderTime > b.loadTime + b.renderTime;
+    });
+
+    QJsonArray slowestSvgs;
+    for (int i = 0; i < qMin(slowest, sorted.count()); ++i) {
+        const Result &result = sorted.at(i);
+        QJsonObject svg;
+        svg.insert(QStringLiteral("imagePath"), result.imagePath);
+        svg.insert(QStringLiteral("file"), result.svgPath);
+        svg.insert(QStringLiteral("loadMs"), result.loadTime / 1000000.0);
+        svg.insert(QStringLiteral("renderMs"), result.renderTime / 1000000.0);
+        svg.insert(QStringLiteral("images"), result.imageCount);
+        slowestSvgs.append(svg);
+    }
+
+    QJsonObject report;
+    report.insert(QStringLiteral("version"), s_reportVersion);
+    report.insert(QStringLiteral("theme"), theme);
+    report.insert(QStringLiteral("sizes"), sizes);
+    report.insert(QStringLiteral("scales"), scales);
+    report.insert(QStringLiteral("svgs"), results.count());
+    report.insert(QStringLiteral("images"), images);
+    report.insert(QStringLiteral("loadFailures"), failures);
+    if (!m_parameters.baselineDir.isEmpty()) {
+        report.insert(QStringLiteral("mismatches"), mismatches);
+        report.insert(QStringLiteral("missingBaselines"), missing);
+    }
+    report.insert(QStringLiteral("slowest"), slowestSvgs);
+    return report;
+}
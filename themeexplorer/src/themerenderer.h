@@ -0,0 +1,99 @@
+/*
+ *   Copyright 2026 agent <agent@local>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Library General Public License as
+ *   published by the Free Software Foundation; either version 2, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details
+ *
+ *   You should have received a copy of the GNU Library General Public
+ *   License along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef THEMERENDERER_H
+#define THEMERENDERER_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+#include <QVector>
+
+class QImage;
+class QSvgRenderer;
+class ThemeModel;
+
+/**
+ * Renders the elements and frames of every svg a ThemeModel lists into
+ * png files, without showing anything, and optionally compares them with
+ * the pngs of an earlier run.
+ *
+ * Every svg is loaded and rendered by its own QSvgRenderer in a thread of
+ * the global thread pool; how long that took is recorded per svg.
+ */
+class ThemeRenderer
+{
+public:
+    struct Parameters {
+        // edge lengths in device independent pixels
+        QList<int> sizes;
+        QList<qreal> scales;
+        QString outputDir;
+        // the output directory of an earlier run; nothing is compared if empty
+        QString baselineDir;
+        // the largest difference of a color channel still counted as equal
+        int tolerance = 0;
+    };
+
+    struct Result {
+        QString imagePath;
+        QString svgPath;
+        bool valid = false;
+        qint64 loadTime = 0;
+        qint64 renderTime = 0;
+        int imageCount = 0;
+        // pngs relative to the output directory
+        QStringList mismatches;
+        QStringList missing;
+    };
+
+    explicit ThemeRenderer(const Parameters &parameters);
+    ~ThemeRenderer();
+
+    /**
+     * Renders all the svgs of the current theme of @p model, blocking until
+     * all of them are done.
+     */
+    QVector<Result> render(const ThemeModel *model) const;
+
+    /**
+     * @return the results as a JSON document, with the @p slowest svgs
+     * taking the longest to load and render first
+     */
+    QJsonObject report(const QString &theme, const QVector<Result> &results, int slowest) const;
+
+private:
+    struct Job {
+        QString imagePath;
+        QString svgPath;
+        QStringList ids;
+        QStringList prefixes;
+    };
+
+    Result renderJob(const Job &job) const;
+    void renderElement(QSvgRenderer &renderer, const QString &id, int size, qreal scale, QImage &image) const;
+    void renderFrame(QSvgRenderer &renderer, const QString &prefix, int size, qreal scale, QImage &image) const;
+    // @return false if @p image differs from its baseline, which then gets
+    // a diff image next to it
+    bool compare(const QImage &image, const QString &fileName, Result &result) const;
+
+    Parameters m_parameters;
+};
+
+#endif // THEMERENDERER_H